@@ -1,16 +1,76 @@
 #include <iostream>
 #include <fstream>
 #include <string>
+#include <cstring>
+#include <cstdlib>
+#include <cctype>
 #include <sstream>
 #include <vector>
+#include <algorithm>
+#include <type_traits>
+#include <deque>
+#include <climits>
+#include <cerrno>
+#include <cmath>
 #include <iomanip>
 #include <chrono>
+#include <thread>
+#include <mutex>
+#if __cplusplus >= 201402L
+#define CONSTEXPR14 constexpr
+#else
+#define CONSTEXPR14 inline
+#endif
+#if defined(__GNUC__) && (__GNUC__ >= 8 || defined(__clang__))
+#define UNROLL _Pragma("GCC unroll 16")
+#else
+#define UNROLL
+#endif
+#if defined(__GNUC__) && defined(__x86_64__)
+#define X86_SIMD
+#include <immintrin.h>
+#endif
 #if defined(WIN32) || defined(_WIN32) || defined(__WIN32) && !defined(__CYGWIN__)
 #define WINDOWS
 #include "windows.h"
+#include <io.h>
+#include <fcntl.h>
 #else
 #define LINUX
 #include <dlfcn.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#endif
+// bigint algorithm crossovers; a header written by the BIGINT_BENCHMARK tuner overrides the defaults.
+// The defaults were measured by CPU time on an x86-64 Xeon (KVM guest, g++ 12 -O2, one thread)
+#ifdef BIGINT_THRESHOLDS
+#include BIGINT_THRESHOLDS
+#endif
+#ifndef BIGINT_DECIMAL_KARATSUBA_THRESHOLD
+#define BIGINT_DECIMAL_KARATSUBA_THRESHOLD 32
+#endif
+#ifndef BIGINT_DECIMAL_TOOM3_THRESHOLD
+#define BIGINT_DECIMAL_TOOM3_THRESHOLD 2000
+#endif
+#ifndef BIGINT_DECIMAL_NTT_THRESHOLD
+#define BIGINT_DECIMAL_NTT_THRESHOLD 8000
+#endif
+#ifndef BIGINT_DECIMAL_DIVISION_THRESHOLD
+#define BIGINT_DECIMAL_DIVISION_THRESHOLD 100
+#endif
+#ifndef BIGINT_BINARY_KARATSUBA_THRESHOLD
+#define BIGINT_BINARY_KARATSUBA_THRESHOLD 32
+#endif
+#ifndef BIGINT_BINARY_TOOM3_THRESHOLD
+#define BIGINT_BINARY_TOOM3_THRESHOLD 2000
+#endif
+#ifndef BIGINT_BINARY_NTT_THRESHOLD
+#define BIGINT_BINARY_NTT_THRESHOLD 7000
+#endif
+#ifndef BIGINT_BINARY_DIVISION_THRESHOLD
+#define BIGINT_BINARY_DIVISION_THRESHOLD 3000
 #endif
 
 namespace libs {
@@ -73,592 +133,4908 @@ namespace libs {
 
             return (negative ? -int64(result) : result);
         }
-        float64 double_from_string(char* str) {
-            bool negative = false;
-            int c;
+        uint32 pow_mod(uint32 num, uint64 exp, uint32 mod) {
+            uint64 result = 1, base = num % mod;
+            while (exp > 0) {
+                if (exp % 2 == 1)
+                    result = result * base % mod;
+                exp /= 2;
+                base = base * base % mod;
+            }
+            return (uint32) result;
+        }
+        // deterministic Miller-Rabin, the bases 2, 7 and 61 cover every 32-bit n
+        bool is_prime(uint32 n) {
+            if (n < 2)
+                return false;
+            for (uint32 p : {2u, 3u, 5u, 7u, 61u})
+                if (n % p == 0)
+                    return n == p;
+            uint32 d = n - 1;
+            int s = 0;
+            for (; d % 2 == 0; d /= 2)
+                s++;
+            for (uint32 b : {2u, 7u, 61u}) {
+                uint64 x = pow_mod(b, d, n);
+                if (x == 1 || x == n - 1)
+                    continue;
+                bool composite = true;
+                for (int i = 1; i < s && composite; i++) {
+                    x = x * x % n;
+                    composite = x != n - 1;
+                }
+                if (composite)
+                    return false;
+            }
+            return true;
+        }
+        // x < 10^9, written zero-padded to exactly nine characters
+        void write_nine_digits(char *buf, uint32 x) {
+            static const char pairs[] =
+                    "00010203040506070809101112131415161718192021222324252627282930313233343536373839"
+                    "40414243444546474849505152535455565758596061626364656667686970717273747576777879"
+                    "8081828384858687888990919293949596979899";
+            buf[0] = char('0' + x / 100000000);
+            x %= 100000000;
+            for (int i = 7; i > 0; i -= 2, x /= 100) {
+                buf[i] = pairs[2 * (x % 100)];
+                buf[i + 1] = pairs[2 * (x % 100) + 1];
+            }
+        }
+        // correctly rounded, see __decimal_to_float
+        float64 double_from_string(char* str);
+        float32 float_from_string(char* str);
+    }
+
+    template<uint32 mod, uint32 root>
+    struct __ntt_prime {
+        // roots for transforms of length up to n. A longer table is built as a new copy and the old ones are
+        // kept, so a table handed out stays valid and unchanged while other threads grow the cache
+        static const uint32 *roots(int n) {
+            static std::mutex lock;
+            static std::deque<std::vector<uint32>> tables(1, std::vector<uint32>(2, 1));
+            std::lock_guard<std::mutex> guard(lock);
+            if ((int) tables.back().size() < n) {
+                std::vector<uint32> rt = tables.back();
+                for (int k = rt.size(); k < n; k *= 2) {
+                    rt.resize(2 * k);
+                    uint64 z = math::pow_mod(root, (mod - 1) / (2 * k), mod);
+                    for (int i = k; i < 2 * k; i++)
+                        rt[i] = i & 1 ? rt[i / 2] * z % mod : rt[i / 2];
+                }
+                tables.push_back(std::move(rt));
+            }
+            return tables.back().data();
+        }
+
+        static void transform(std::vector<uint32> &a, int n) {
+            const uint32 *rt = roots(n);
+            for (int i = 1, j = 0; i < n; i++) {
+                int bit = n >> 1;
+                for (; j & bit; bit >>= 1)
+                    j ^= bit;
+                j ^= bit;
+                if (i < j)
+                    std::swap(a[i], a[j]);
+            }
+            for (int k = 1; k < n; k *= 2)
+                for (int i = 0; i < n; i += 2 * k)
+                    for (int j = 0; j < k; j++) {
+                        uint32 z = (uint64) rt[j + k] * a[i + j + k] % mod;
+                        uint32 &ai = a[i + j];
+                        a[i + j + k] = ai - z + (z > ai ? mod : 0);
+                        ai += (ai + z >= mod ? z - mod : z);
+                    }
+        }
+
+        // cyclic convolution of length n (a power of two), result is reduced modulo mod;
+        // a square (&a == &b) takes one forward transform
+        static std::vector<uint32> convolve(const std::vector<uint32> &a, const std::vector<uint32> &b, int n) {
+            std::vector<uint32> fa(n), fb, res(n);
+            for (int i = 0; i < (int) a.size(); i++)
+                fa[i] = a[i] % mod;
+            transform(fa, n);
+            if (&a == &b) {
+                fb = fa;
+            } else {
+                fb.resize(n);
+                for (int i = 0; i < (int) b.size(); i++)
+                    fb[i] = b[i] % mod;
+                transform(fb, n);
+            }
+            uint64 inv = math::pow_mod(n, mod - 2, mod);
+            for (int i = 0; i < n; i++)
+                res[-i & (n - 1)] = (uint64) fa[i] * fb[i] % mod * inv % mod;
+            transform(res, n);
+            return res;
+        }
+    };
+
+    typedef __ntt_prime<2013265921, 31> __ntt_prime1;
+    typedef __ntt_prime<469762049, 3> __ntt_prime2;
+    typedef __ntt_prime<167772161, 3> __ntt_prime3;
+
+    // decimal conversion for integer types whose limbs are not decimal: values are split by
+    // cached powers 10^(9 * 2^k) and their reciprocals, so a conversion costs a few multiplications of full size
+    template<typename Int>
+    struct __decimal_conversion {
+        static const int base_case_digits = bigint_base_digits * 16;
+
+        static int chunk_digits(int k) {
+            return bigint_base_digits << k;
+        }
+
+        // 10^(chunk_digits(k)), references stay valid as the cache grows; safe to call from several threads
+        static const Int &power(int k) {
+            static std::mutex lock;
+            static std::deque<Int> powers;
+            std::lock_guard<std::mutex> guard(lock);
+            while ((int) powers.size() <= k)
+                powers.push_back(powers.empty() ? Int(bigint_base) : powers.back() * powers.back());
+            return powers[k];
+        }
+
+        // base^(2n) / power(k) for the n limbs of power(k), rounded down to a multiple of the normalization
+        // factor f: the reciprocal of the normalized power times f. Computed once per power
+        static const Int &inverse(int k) {
+            typedef typename Int::K K;
+            static std::mutex lock;
+            static std::deque<Int> inverses;
+            std::lock_guard<std::mutex> guard(lock);
+            while ((int) inverses.size() <= k) {
+                const Int &p = power(inverses.size());
+                int n = p.a.size();
+                typename Int::limb f = K::normalizer(p.a.back());
+                Int v;
+                v.a.resize(n);
+                K::normalize(v.a.data(), p.a.data(), n, f);
+                Int x = Int::reciprocal(v);
+                x.a.push_back(K::normalize(x.a.data(), x.a.data(), x.a.size(), f));
+                x.trim();
+                inverses.push_back(std::move(x));
+            }
+            return inverses[k];
+        }
+
+        // quotient and remainder of 0 <= x < power(k)^2 by power(k), at the cost of two multiplications.
+        // The estimate from the leading limbs of x is never above the quotient and at most 3 below it
+        static std::pair<Int, Int> split(const Int &x, int k) {
+            const Int &p = power(k);
+            int n = p.a.size();
+            Int q = (x.shift_limbs(1 - n) * inverse(k)).shift_limbs(-n - 1), r = x - q * p;
+            while (!(r < p))
+                q += 1, r -= p;
+            return std::make_pair(q, r);
+        }
+
+        // [first, last) holds decimal digits only
+        static Int read(const char *first, const char *last) {
+            int len = last - first;
+            if (len <= base_case_digits) {
+                Int x(0);
+                for (int chunk = (len - 1) % bigint_base_digits + 1; first < last; chunk = bigint_base_digits) {
+                    int limb = 0, scale = 1;
+                    for (int i = 0; i < chunk; i++, scale *= 10)
+                        limb = limb * 10 + *first++ - '0';
+                    x *= scale;
+                    x += limb;
+                }
+                return x;
+            }
+            int k = 0;
+            while (chunk_digits(k + 1) < len)
+                k++;
+            return read(first, last - chunk_digits(k)) * power(k) + read(last - chunk_digits(k), last);
+        }
+
+        // 0 <= x < power(k), written as exactly chunk_digits(k) digits
+        static char *write_padded(const Int &x, int k, char *buf) {
+            if (chunk_digits(k) <= base_case_digits) {
+                typename Int::K::divisor d(bigint_base);
+                Int y = x;
+                for (int i = (1 << k) - 1; i >= 0; i--) {
+                    math::write_nine_digits(buf + i * bigint_base_digits, d.divrem(y.a.data(), y.a.data(), y.a.size()));
+                    y.trim();
+                }
+                return buf + chunk_digits(k);
+            }
+            std::pair<Int, Int> qr = split(x, k - 1);
+            buf = write_padded(qr.first, k - 1, buf);
+            return write_padded(qr.second, k - 1, buf);
+        }
+
+        // x >= 0, written without leading zeros
+        static char *write(const Int &x, char *buf) {
+            int k = 0;
+            while (!(x < power(k)))
+                k++;
+            if (chunk_digits(k) <= base_case_digits) {
+                char digits[base_case_digits];
+                char *end = write_padded(x, k, digits), *first = digits;
+                while (first + 1 < end && *first == '0')
+                    first++;
+                return std::copy(first, end, buf);
+            }
+            // a short quotient is cheaper to get from a division than from a full-size reciprocal
+            const Int &p = power(k - 1);
+            std::pair<Int, Int> qr = 4 * (x.a.size() - p.a.size()) < p.a.size() ? divmod(x, p) : split(x, k - 1);
+            buf = write(qr.first, buf);
+            return write_padded(qr.second, k - 1, buf);
+        }
+    };
+
+    // vector of trivially copyable values that keeps up to N of them inline, so short
+    // sequences never touch the heap. Iterators are plain pointers
+    template<typename T, int N>
+    class __small_vector {
+    private:
+        T *ptr;
+        size_t len, cap;
+        T buf[N];
+
+        bool is_inline() const {
+            return ptr == buf;
+        }
+
+        void grow(size_t need) {
+            size_t c = std::max(need, cap * 2);
+            T *p = new T[c];
+            std::copy(ptr, ptr + len, p);
+            if (!is_inline())
+                delete[] ptr;
+            ptr = p;
+            cap = c;
+        }
+
+    public:
+        typedef T value_type;
+        typedef T *iterator;
+        typedef const T *const_iterator;
+
+        __small_vector() :
+                ptr(buf), len(0), cap(N) {
+        }
+
+        explicit __small_vector(size_t n, const T &v = T()) :
+                ptr(buf), len(0), cap(N) {
+            assign(n, v);
+        }
+
+        __small_vector(const T *first, const T *last) :
+                ptr(buf), len(0), cap(N) {
+            assign(first, last);
+        }
+
+        __small_vector(const __small_vector &v) :
+                ptr(buf), len(0), cap(N) {
+            assign(v.begin(), v.end());
+        }
+
+        __small_vector(__small_vector &&v) :
+                ptr(buf), len(0), cap(N) {
+            *this = std::move(v);
+        }
+
+        ~__small_vector() {
+            if (!is_inline())
+                delete[] ptr;
+        }
+
+        __small_vector& operator=(const __small_vector &v) {
+            if (this != &v)
+                assign(v.begin(), v.end());
+            return *this;
+        }
+
+        __small_vector& operator=(__small_vector &&v) {
+            if (this == &v)
+                return *this;
+            if (v.is_inline()) {
+                assign(v.begin(), v.end());
+            } else {
+                if (!is_inline())
+                    delete[] ptr;
+                ptr = v.ptr;
+                cap = v.cap;
+                len = v.len;
+                v.ptr = v.buf;
+                v.cap = N;
+            }
+            v.len = 0;
+            return *this;
+        }
+
+        void swap(__small_vector &v) {
+            __small_vector t(std::move(v));
+            v = std::move(*this);
+            *this = std::move(t);
+        }
+
+        size_t size() const {
+            return len;
+        }
+
+        size_t capacity() const {
+            return cap;
+        }
+
+        bool empty() const {
+            return len == 0;
+        }
+
+        T *data() {
+            return ptr;
+        }
+
+        const T *data() const {
+            return ptr;
+        }
+
+        T *begin() {
+            return ptr;
+        }
+
+        const T *begin() const {
+            return ptr;
+        }
+
+        T *end() {
+            return ptr + len;
+        }
+
+        const T *end() const {
+            return ptr + len;
+        }
+
+        T &operator[](size_t i) {
+            return ptr[i];
+        }
+
+        const T &operator[](size_t i) const {
+            return ptr[i];
+        }
+
+        T &back() {
+            return ptr[len - 1];
+        }
+
+        const T &back() const {
+            return ptr[len - 1];
+        }
+
+        void reserve(size_t n) {
+            if (n > cap)
+                grow(n);
+        }
+
+        void clear() {
+            len = 0;
+        }
+
+        void push_back(const T &v) {
+            if (len == cap)
+                grow(len + 1);
+            ptr[len++] = v;
+        }
+
+        void pop_back() {
+            len--;
+        }
+
+        void resize(size_t n, const T &v = T()) {
+            reserve(n);
+            if (n > len)
+                std::fill(ptr + len, ptr + n, v);
+            len = n;
+        }
+
+        void assign(size_t n, const T &v) {
+            len = 0;
+            resize(n, v);
+        }
+
+        // [first, last) must not point into this vector
+        void assign(const T *first, const T *last) {
+            len = 0;
+            reserve(last - first);
+            len = std::copy(first, last, ptr) - ptr;
+        }
+
+        void insert(T *pos, const T *first, const T *last) {
+            size_t at = pos - ptr, n = last - first;
+            reserve(len + n);
+            std::copy_backward(ptr + at, ptr + len, ptr + len + n);
+            std::copy(first, last, ptr + at);
+            len += n;
+        }
+
+        bool operator==(const __small_vector &v) const {
+            return len == v.len && std::equal(ptr, ptr + len, v.ptr);
+        }
+    };
+
+    // AVX2 kernels for base 10^9 limbs, chosen at run time when the CPU supports them. Each returns
+    // false to leave the work to the portable loops, which the templates always do for other limb types
+    struct __decimal_simd {
+        static const uint32 base = 1000000000;
+
+        static bool enabled() {
+#ifdef X86_SIMD
+            static const bool avx2 = __builtin_cpu_supports("avx2");
+            return avx2;
+#else
+            return false;
+#endif
+        }
+
+        template<typename T>
+        static bool add_n(T *, const T *, const T *, int, T &) {
+            return false;
+        }
+
+        static bool add_n(uint32 *r, const uint32 *x, const uint32 *y, int n, uint32 &carry) {
+#ifdef X86_SIMD
+            if (n >= 16 && enabled()) {
+                carry = avx2_add_n(r, x, y, n);
+                return true;
+            }
+#endif
+            return false;
+        }
+
+        template<typename T>
+        static bool sub_n(T *, const T *, const T *, int, T &) {
+            return false;
+        }
+
+        static bool sub_n(uint32 *r, const uint32 *x, const uint32 *y, int n, uint32 &borrow) {
+#ifdef X86_SIMD
+            if (n >= 16 && enabled()) {
+                borrow = avx2_sub_n(r, x, y, n);
+                return true;
+            }
+#endif
+            return false;
+        }
+
+        template<typename T>
+        static bool mul_1(T *, const T *, int, T, T &) {
+            return false;
+        }
+
+        static bool mul_1(uint32 *r, const uint32 *x, int n, uint32 m, uint32 &carry) {
+#ifdef X86_SIMD
+            if (n >= 8 && enabled()) {
+                carry = avx2_mul_1(r, x, n, m);
+                return true;
+            }
+#endif
+            return false;
+        }
+
+        template<typename T>
+        static bool basecase_mul(T *, const T *, int, const T *, int) {
+            return false;
+        }
+
+        static bool basecase_mul(uint32 *r, const uint32 *x, int xn, const uint32 *y, int yn) {
+#ifdef X86_SIMD
+            if (yn >= 8 && enabled()) {
+                avx2_basecase_mul(r, x, xn, y, yn);
+                return true;
+            }
+#endif
+            return false;
+        }
+
+#ifdef X86_SIMD
+        // s + carries, for eight lane sums below 2 * base: the carry into a lane comes from the lanes that
+        // generate one (s >= base) and the runs of lanes that propagate it (s == base - 1)
+        __attribute__((target("avx2")))
+        static __m256i carry_lanes(__m256i s, uint32 &carry) {
+            const __m256i top = _mm256_set1_epi32(base - 1), b = _mm256_set1_epi32(base);
+            const __m256i bit = _mm256_setr_epi32(1, 2, 4, 8, 16, 32, 64, 128);
+            // the sums stay below 2^31, so signed comparisons are exact
+            uint32 g = _mm256_movemask_ps(_mm256_castsi256_ps(_mm256_cmpgt_epi32(s, top)));
+            uint32 p = _mm256_movemask_ps(_mm256_castsi256_ps(_mm256_cmpeq_epi32(s, top)));
+            uint32 c = ((g << 1 | carry) + p) ^ p;
+            carry = c >> 8 & 1;
+            s = _mm256_sub_epi32(s, _mm256_cmpeq_epi32(_mm256_and_si256(_mm256_set1_epi32(c), bit), bit));
+            return _mm256_sub_epi32(s, _mm256_and_si256(_mm256_cmpgt_epi32(s, top), b));
+        }
+
+        __attribute__((target("avx2")))
+        static uint32 avx2_add_n(uint32 *r, const uint32 *x, const uint32 *y, int n) {
+            uint32 carry = 0;
+            int i = 0;
+            for (; i + 8 <= n; i += 8) {
+                __m256i s = _mm256_add_epi32(_mm256_loadu_si256((const __m256i *) (x + i)),
+                                             _mm256_loadu_si256((const __m256i *) (y + i)));
+                _mm256_storeu_si256((__m256i *) (r + i), carry_lanes(s, carry));
+            }
+            for (; i < n; i++) {
+                uint32 s = x[i] + y[i] + carry;
+                carry = s >= base;
+                r[i] = carry ? s - base : s;
+            }
+            return carry;
+        }
+
+        // r = x - y by the lane trick of carry_lanes: negative differences generate a borrow, zero ones propagate it
+        __attribute__((target("avx2")))
+        static uint32 avx2_sub_n(uint32 *r, const uint32 *x, const uint32 *y, int n) {
+            const __m256i zero = _mm256_setzero_si256(), b = _mm256_set1_epi32(base);
+            const __m256i bit = _mm256_setr_epi32(1, 2, 4, 8, 16, 32, 64, 128);
+            uint32 borrow = 0;
+            int i = 0;
+            for (; i + 8 <= n; i += 8) {
+                __m256i d = _mm256_sub_epi32(_mm256_loadu_si256((const __m256i *) (x + i)),
+                                             _mm256_loadu_si256((const __m256i *) (y + i)));
+                uint32 g = _mm256_movemask_ps(_mm256_castsi256_ps(_mm256_cmpgt_epi32(zero, d)));
+                uint32 p = _mm256_movemask_ps(_mm256_castsi256_ps(_mm256_cmpeq_epi32(d, zero)));
+                uint32 c = ((g << 1 | borrow) + p) ^ p;
+                borrow = c >> 8 & 1;
+                __m256i in = _mm256_cmpeq_epi32(_mm256_and_si256(_mm256_set1_epi32(c), bit), bit);
+                d = _mm256_add_epi32(d, in);
+                d = _mm256_add_epi32(d, _mm256_and_si256(_mm256_cmpgt_epi32(zero, d), b));
+                _mm256_storeu_si256((__m256i *) (r + i), d);
+            }
+            for (; i < n; i++) {
+                uint32 d = x[i] - y[i] - borrow;
+                borrow = x[i] < y[i] + borrow;
+                r[i] = borrow ? d + base : d;
+            }
+            return borrow;
+        }
+
+        // splits four products below 10^18 into quotient and remainder by 10^9: p / 2^9 is exact in a
+        // double, a multiply by 1 / 5^9 is off by at most one and the remainder check corrects it
+        __attribute__((target("avx2")))
+        static __m256i split_base(__m256i p, __m256i &lo) {
+            const __m256i magic = _mm256_set1_epi64x(0x4330000000000000ll);
+            const __m256i b = _mm256_set1_epi64x(base), top = _mm256_set1_epi64x(base - 1);
+            const __m256d two52 = _mm256_set1_pd(4503599627370496.0);
+            __m256d d = _mm256_sub_pd(_mm256_castsi256_pd(_mm256_or_si256(_mm256_srli_epi64(p, 9), magic)), two52);
+            d = _mm256_floor_pd(_mm256_mul_pd(d, _mm256_set1_pd(1.0 / 1953125)));
+            __m256i q = _mm256_sub_epi64(_mm256_castpd_si256(_mm256_add_pd(d, two52)), magic);
+            lo = _mm256_sub_epi64(p, _mm256_mul_epu32(q, b));
+            __m256i low = _mm256_cmpgt_epi64(_mm256_setzero_si256(), lo);
+            __m256i high = _mm256_cmpgt_epi64(lo, top);
+            lo = _mm256_add_epi64(lo, _mm256_and_si256(low, b));
+            lo = _mm256_sub_epi64(lo, _mm256_and_si256(high, b));
+            return _mm256_add_epi64(_mm256_add_epi64(q, low), _mm256_sub_epi64(_mm256_setzero_si256(), high));
+        }
+
+        // r = x * m for m < base, eight limbs at a time: the products are split without a carry chain,
+        // each limb adds the high part of its neighbour and carry_lanes resolves what is left
+        __attribute__((target("avx2")))
+        static uint32 avx2_mul_1(uint32 *r, const uint32 *x, int n, uint32 m) {
+            const __m256i vm = _mm256_set1_epi64x(m), pack = _mm256_setr_epi32(0, 2, 4, 6, 1, 3, 5, 7);
+            __m256i prev = _mm256_setzero_si256();
+            uint32 carry = 0;
+            int i = 0;
+            for (; i + 8 <= n; i += 8) {
+                __m256i lo0, lo1;
+                __m256i hi0 = split_base(_mm256_mul_epu32(_mm256_cvtepu32_epi64(_mm_loadu_si128((const __m128i *) (x + i))), vm), lo0);
+                __m256i hi1 = split_base(_mm256_mul_epu32(_mm256_cvtepu32_epi64(_mm_loadu_si128((const __m128i *) (x + i + 4))), vm), lo1);
+                // low halves of the 64-bit lanes packed into eight 32-bit lanes
+                __m256i lo = _mm256_permute2x128_si256(_mm256_permutevar8x32_epi32(lo0, pack), _mm256_permutevar8x32_epi32(lo1, pack), 0x20);
+                __m256i hi = _mm256_permute2x128_si256(_mm256_permutevar8x32_epi32(hi0, pack), _mm256_permutevar8x32_epi32(hi1, pack), 0x20);
+                // hi moved up one lane, the previous block's last high part entering lane 0
+                __m256i up = _mm256_permutevar8x32_epi32(hi, _mm256_setr_epi32(7, 0, 1, 2, 3, 4, 5, 6));
+                up = _mm256_blend_epi32(up, prev, 0x01);
+                prev = _mm256_permutevar8x32_epi32(hi, _mm256_set1_epi32(7));
+                _mm256_storeu_si256((__m256i *) (r + i), carry_lanes(_mm256_add_epi32(lo, up), carry));
+            }
+            uint64 c = uint64(_mm256_cvtsi256_si32(prev)) + carry;
+            for (; i < n; i++) {
+                c += (uint64) x[i] * m;
+                r[i] = uint32(c % base);
+                c /= base;
+            }
+            return uint32(c);
+        }
+
+        // r = x * y with deferred carries: rows of products below 10^18 are summed into 64-bit columns
+        // and the columns are carried once every 18 rows, before the sums could overflow
+        __attribute__((target("avx2")))
+        static void avx2_basecase_mul(uint32 *r, const uint32 *x, int xn, const uint32 *y, int yn) {
+            const int rows = 18;
+            uint64 stack[128];
+            std::vector<uint64> heap;
+            uint64 *acc = stack;
+            if (xn + yn > 128) {
+                heap.resize(xn + yn);
+                acc = heap.data();
+            }
+            std::fill(acc, acc + xn + yn, 0);
+            for (int i0 = 0; i0 < xn; i0 += rows) {
+                int i1 = std::min(xn, i0 + rows);
+                for (int i = i0; i < i1; i++) {
+                    __m256i m = _mm256_set1_epi64x(x[i]);
+                    uint64 *t = acc + i;
+                    int j = 0;
+                    for (; j + 4 <= yn; j += 4) {
+                        __m256i v = _mm256_cvtepu32_epi64(_mm_loadu_si128((const __m128i *) (y + j)));
+                        __m256i s = _mm256_add_epi64(_mm256_loadu_si256((const __m256i *) (t + j)), _mm256_mul_epu32(v, m));
+                        _mm256_storeu_si256((__m256i *) (t + j), s);
+                    }
+                    for (; j < yn; j++)
+                        t[j] += (uint64) x[i] * y[j];
+                }
+                // columns below i0 are final; the carry out of the block lands in column i1 + yn
+                uint64 c = 0;
+                for (int k = i0; k < i1 + yn; k++) {
+                    uint64 v = acc[k] + c;
+                    acc[k] = v % base;
+                    c = v / base;
+                }
+                if (i1 + yn < xn + yn)
+                    acc[i1 + yn] = c;
+            }
+            for (int k = 0; k < xn + yn; k++)
+                r[k] = uint32(acc[k]);
+        }
+#endif
+    };
+
+    // threads one bigint product may use; 1, the default, keeps multiplication on the calling thread
+    int &bigint_threads() {
+        static int threads = 1;
+        return threads;
+    }
+
+    // limb policies for basic_bigint. Decimal limbs keep I/O linear, binary limbs carry
+    // in native words and are decimal-converted only when read or printed
+    struct decimal_limbs {
+        typedef uint32 limb;
+        typedef uint64 dlimb;
+        static const bool decimal = true;
+        // NTT digits per limb, their radix and the longest transform the primes keep exact
+        static const int ntt_digits = 1;
+        static const uint64 ntt_radix = 1000000000;
+        static const int ntt_max_digits = 1 << 25;
+        // limbs stored without a heap allocation, enough for products of 36-digit values
+        static const int inline_limbs = 8;
+        // algorithm crossovers in limbs; the defaults were measured on x86-64 with g++ -O2 and the AVX2 kernels
+        static const int karatsuba_threshold = BIGINT_DECIMAL_KARATSUBA_THRESHOLD;
+        static const int toom3_threshold = BIGINT_DECIMAL_TOOM3_THRESHOLD;
+        static const int ntt_threshold = BIGINT_DECIMAL_NTT_THRESHOLD;
+        static const int division_threshold = BIGINT_DECIMAL_DIVISION_THRESHOLD;
+        static const int hgcd_threshold = 100;
+        // shortest product, in limbs of the longer operand, that bigint_threads() may spread over threads
+        static const int parallel_threshold = 1500;
+
+        static dlimb base() {
+            return 1000000000;
+        }
+
+        static limb low(dlimb v) {
+            return limb(v % 1000000000);
+        }
+
+        static dlimb high(dlimb v) {
+            return v / 1000000000;
+        }
+
+        static limb add(limb x, limb y, limb &carry) {
+            limb s = x + y + carry;
+            carry = s >= 1000000000;
+            return carry ? s - 1000000000 : s;
+        }
+
+        static limb sub(limb x, limb y, limb &borrow) {
+            limb s = x - y - borrow;
+            borrow = x < y + borrow;
+            return borrow ? s + 1000000000 : s;
+        }
+    };
+
+    struct binary_limbs {
+        typedef uint64 limb;
+        typedef unsigned __int128 dlimb;
+        static const bool decimal = false;
+        static const int ntt_digits = 2;
+        static const uint64 ntt_radix = 1ull << 32;
+        static const int ntt_max_digits = 1 << 23;
+        static const int inline_limbs = 4;
+        static const int karatsuba_threshold = BIGINT_BINARY_KARATSUBA_THRESHOLD;
+        static const int toom3_threshold = BIGINT_BINARY_TOOM3_THRESHOLD;
+        static const int ntt_threshold = BIGINT_BINARY_NTT_THRESHOLD;
+        static const int division_threshold = BIGINT_BINARY_DIVISION_THRESHOLD;
+        static const int hgcd_threshold = 150;
+        static const int parallel_threshold = 1500;
+
+        static dlimb base() {
+            return dlimb(1) << 64;
+        }
+
+        static limb low(dlimb v) {
+            return limb(v);
+        }
+
+        static dlimb high(dlimb v) {
+            return v >> 64;
+        }
+
+        static limb add(limb x, limb y, limb &carry) {
+            dlimb s = (dlimb) x + y + carry;
+            carry = limb(s >> 64);
+            return limb(s);
+        }
+
+        static limb sub(limb x, limb y, limb &borrow) {
+            limb s = x - y - borrow;
+            borrow = x < y || (x == y && borrow);
+            return s;
+        }
+    };
+
+    // raw limb-span kernels under basic_bigint, after GMP's mpn layer. A span is a pointer and
+    // a length, results go to memory owned by the caller. Elementwise kernels allow r == x
+    template<typename L>
+    struct __mpn {
+        typedef typename L::limb limb;
+        typedef typename L::dlimb dlimb;
+
+        static const int limb_bits = sizeof(limb) * 8;
+
+        static limb mul_add(limb x, limb y, limb c, limb &carry) {
+            dlimb p = (dlimb) x * y + c + carry;
+            carry = limb(L::high(p));
+            return L::low(p);
+        }
+
+        static int cmp(const limb *x, const limb *y, int n) {
+            for (int i = n - 1; i >= 0; i--)
+                if (x[i] != y[i])
+                    return x[i] < y[i] ? -1 : 1;
+            return 0;
+        }
+
+        // r = x + y, returns the carry
+        static limb add_n(limb *r, const limb *x, const limb *y, int n) {
+            limb carry = 0;
+            if (__decimal_simd::add_n(r, x, y, n, carry))
+                return carry;
+            for (int i = 0; i < n; i++)
+                r[i] = L::add(x[i], y[i], carry);
+            return carry;
+        }
+
+        // r = x + c, c < base
+        static limb add_1(limb *r, const limb *x, int n, limb c) {
+            int i = 0;
+            for (; i < n && c; i++) {
+                limb carry = 0;
+                r[i] = L::add(x[i], c, carry);
+                c = carry;
+            }
+            if (r != x)
+                std::copy(x + i, x + n, r + i);
+            return c;
+        }
+
+        // r = x + y, xn >= yn
+        static limb add(limb *r, const limb *x, int xn, const limb *y, int yn) {
+            return add_1(r + yn, x + yn, xn - yn, add_n(r, x, y, yn));
+        }
+
+        // r = x - y, returns the borrow
+        static limb sub_n(limb *r, const limb *x, const limb *y, int n) {
+            limb borrow = 0;
+            if (__decimal_simd::sub_n(r, x, y, n, borrow))
+                return borrow;
+            for (int i = 0; i < n; i++)
+                r[i] = L::sub(x[i], y[i], borrow);
+            return borrow;
+        }
+
+        // r = x - b, b < base
+        static limb sub_1(limb *r, const limb *x, int n, limb b) {
+            int i = 0;
+            for (; i < n && b; i++) {
+                limb borrow = 0;
+                r[i] = L::sub(x[i], b, borrow);
+                b = borrow;
+            }
+            if (r != x)
+                std::copy(x + i, x + n, r + i);
+            return b;
+        }
+
+        // r = x - y, xn >= yn
+        static limb sub(limb *r, const limb *x, int xn, const limb *y, int yn) {
+            return sub_1(r + yn, x + yn, xn - yn, sub_n(r, x, y, yn));
+        }
+
+        // r = x * m, returns the high limb
+        static limb mul_1(limb *r, const limb *x, int n, limb m) {
+            limb carry = 0;
+            if (__decimal_simd::mul_1(r, x, n, m, carry))
+                return carry;
+            for (int i = 0; i < n; i++)
+                r[i] = mul_add(x[i], m, 0, carry);
+            return carry;
+        }
+
+        // r += x * m, returns the high limb
+        static limb addmul_1(limb *r, const limb *x, int n, limb m) {
+            limb carry = 0;
+            for (int i = 0; i < n; i++)
+                r[i] = mul_add(x[i], m, r[i], carry);
+            return carry;
+        }
+
+        // r -= x * m, returns the limb still to be subtracted above r
+        static limb submul_1(limb *r, const limb *x, int n, limb m) {
+            // separate carry and borrow chains; the product carry stays below base - 1
+            limb carry = 0, borrow = 0;
+            for (int i = 0; i < n; i++)
+                r[i] = L::sub(r[i], mul_add(x[i], m, 0, carry), borrow);
+            return carry + borrow;
+        }
+
+        // a fixed limb divisor d > 0 with a precomputed reciprocal, so that dividing by it takes a few
+        // multiplications per limb: Granlund and Montgomery's multiply-high on the 64-bit steps of
+        // decimal limbs, Moller and Granlund's 2-by-1 division on the normalized d for binary limbs
+        struct divisor {
+            limb d;
+            uint64 dn, v;
+            int s;
+
+            explicit divisor(limb d) :
+                    d(d) {
+                typedef unsigned __int128 uint128;
+                if (L::decimal) {
+                    // s = ceil(log2 d), v = floor(2^64 (2^s - d) / d) + 1
+                    for (s = 0; (uint64(1) << s) < d; s++);
+                    dn = d;
+                    v = uint64((uint128((uint64(1) << s) - d) << 64) / d) + 1;
+                } else {
+                    s = __builtin_clzll(uint64(d));
+                    dn = uint64(d) << s;
+                    v = uint64((uint128(~dn) << 64 | ~uint64(0)) / dn);
+                }
+            }
+
+            // (r base + x) / d for decimal limbs, r < d; r becomes the remainder
+            uint64 step(uint64 &r, uint64 x) const {
+                uint64 n = r * uint64(L::base()) + x;
+                uint64 t = uint64((unsigned __int128) v * n >> 64);
+                uint64 q = s ? (t + ((n - t) >> 1)) >> (s - 1) : n;
+                r = n - q * dn;
+                return q;
+            }
+
+            // (u1 2^64 + u0) / dn for binary limbs, u1 < dn; u1 becomes the remainder
+            uint64 step_normalized(uint64 &u1, uint64 u0) const {
+                unsigned __int128 p = (unsigned __int128) v * u1 + ((unsigned __int128) u1 << 64 | u0);
+                uint64 q = uint64(p >> 64) + 1, r = u0 - q * dn;
+                if (r > uint64(p)) {
+                    q--;
+                    r += dn;
+                }
+                if (r >= dn) {
+                    q++;
+                    r -= dn;
+                }
+                u1 = r;
+                return q;
+            }
+
+            // q = x / d, returns the remainder; q may equal x and may be null when only the remainder is wanted
+            limb divrem(limb *q, const limb *x, int n) const {
+                uint64 r = 0;
+                if (L::decimal) {
+                    for (int i = n - 1; i >= 0; i--) {
+                        uint64 qi = step(r, x[i]);
+                        if (q)
+                            q[i] = limb(qi);
+                    }
+                    return limb(r);
+                }
+                // the digits of x << s divided by d << s give the same quotient
+                if (s && n > 0)
+                    r = uint64(x[n - 1]) >> (64 - s);
+                for (int i = n - 1; i >= 0; i--) {
+                    uint64 u0 = s ? uint64(x[i]) << s | (i ? uint64(x[i - 1]) >> (64 - s) : 0) : uint64(x[i]);
+                    uint64 qi = step_normalized(r, u0);
+                    if (q)
+                        q[i] = limb(qi);
+                }
+                return limb(r >> s);
+            }
+        };
+
+        // q = x / d, returns the remainder; q may equal x
+        static limb divrem_1(limb *q, const limb *x, int n, limb d) {
+            if (n >= 4)
+                return divisor(d).divrem(q, x, n);
+            limb rem = 0;
+            for (int i = n - 1; i >= 0; i--) {
+                dlimb cur = (dlimb) rem * L::base() + x[i];
+                q[i] = limb(cur / d);
+                rem = limb(cur % d);
+            }
+            return rem;
+        }
+
+        static limb mod_1(const limb *x, int n, limb d) {
+            if (n >= 4)
+                return divisor(d).divrem(nullptr, x, n);
+            limb rem = 0;
+            for (int i = n - 1; i >= 0; i--)
+                rem = limb(((dlimb) rem * L::base() + x[i]) % d);
+            return rem;
+        }
+
+        // r = x << s bitwise, n > 0 and 0 < s < limb_bits, returns the bits shifted out; binary limbs only
+        static limb lshift(limb *r, const limb *x, int n, int s) {
+            limb out = x[n - 1] >> (limb_bits - s);
+            for (int i = n - 1; i > 0; i--)
+                r[i] = limb(x[i] << s) | x[i - 1] >> (limb_bits - s);
+            r[0] = limb(x[0] << s);
+            return out;
+        }
+
+        static void rshift(limb *r, const limb *x, int n, int s) {
+            for (int i = 0; i + 1 < n; i++)
+                r[i] = x[i] >> s | limb(x[i + 1] << (limb_bits - s));
+            r[n - 1] = x[n - 1] >> s;
+        }
+
+        // divisor normalization for Knuth's algorithm D: decimal limbs are multiplied by
+        // base / (top + 1), binary limbs shifted left by the leading zero count of top
+        static limb normalizer(limb top) {
+            if (L::decimal)
+                return limb(L::base() / ((dlimb) top + 1));
+            return __builtin_clzll(uint64(top));
+        }
+
+        // r = x * normalization, returns the overflow limb
+        static limb normalize(limb *r, const limb *x, int n, limb f) {
+            if (L::decimal)
+                return mul_1(r, x, n, f);
+            if (f)
+                return lshift(r, x, n, f);
+            std::copy(x, x + n, r);
+            return 0;
+        }
+
+        static void denormalize(limb *r, const limb *x, int n, limb f) {
+            if (L::decimal)
+                divrem_1(r, x, n, f);
+            else if (f)
+                rshift(r, x, n, f);
+            else
+                std::copy(x, x + n, r);
+        }
+
+        // Knuth's algorithm D. v is normalized (v[vn - 1] >= base / 2) and u[un - 1] < v[vn - 1];
+        // q receives un - vn limbs and u[0, vn) the remainder
+        static void divrem(limb *q, limb *u, int un, const limb *v, int n) {
+            const dlimb base = L::base();
+            limb vt = v[n - 1], vs = n > 1 ? v[n - 2] : 0;
+            for (int j = un - n - 1; j >= 0; j--) {
+                dlimb num = (dlimb) u[j + n] * base + u[j + n - 1];
+                dlimb qhat = num / vt, rhat = num % vt;
+                limb un2 = n > 1 ? u[j + n - 2] : 0;
+                while (qhat >= base || qhat * vs > rhat * base + un2) {
+                    qhat--;
+                    rhat += vt;
+                    if (rhat >= base)
+                        break;
+                }
+                limb borrow = 0;
+                limb top = L::sub(u[j + n], submul_1(u + j, v, n, limb(qhat)), borrow);
+                if (borrow) {
+                    qhat--;
+                    limb carry = add_n(u + j, u + j, v, n);
+                    top = L::add(top, 0, carry);
+                }
+                u[j + n] = top;
+                q[j] = limb(qhat);
+            }
+        }
+
+        // r = x * y, r holds xn + yn limbs and overlaps neither operand
+        static void basecase_mul(limb *r, const limb *x, int xn, const limb *y, int yn) {
+            if (__decimal_simd::basecase_mul(r, x, xn, y, yn))
+                return;
+            r[yn] = mul_1(r, y, yn, x[0]);
+            for (int i = 1; i < xn; i++)
+                r[i + yn] = addmul_1(r + i, y, yn, x[i]);
+        }
+
+        // r = x * x in 2n limbs: the products above the diagonal are summed once and doubled
+        static void basecase_sqr(limb *r, const limb *x, int n) {
+            // the vector convolution outruns the halved scalar square
+            if (__decimal_simd::basecase_mul(r, x, n, x, n))
+                return;
+            r[0] = r[2 * n - 1] = 0;
+            if (n > 1)
+                r[n] = mul_1(r + 1, x + 1, n - 1, x[0]);
+            for (int i = 1; i + 1 < n; i++)
+                r[i + n] = addmul_1(r + 2 * i + 1, x + i + 1, n - i - 1, x[i]);
+            mul_1(r, r, 2 * n, 2);
+            limb carry = 0;
+            for (int i = 0; i < n; i++) {
+                dlimb p = (dlimb) x[i] * x[i];
+                r[2 * i] = L::add(r[2 * i], L::low(p), carry);
+                r[2 * i + 1] = L::add(r[2 * i + 1], limb(L::high(p)), carry);
+            }
+        }
+
+        // scratch limbs mul_n needs for n-limb operands
+        static int mul_n_scratch(int n) {
+            if (n <= L::karatsuba_threshold)
+                return 0;
+            if (n < L::toom3_threshold) {
+                int k = n / 2, h = n - k;
+                return std::max(std::max(mul_n_scratch(k), mul_n_scratch(h)), 4 * (h + 1) + mul_n_scratch(h + 1));
+            }
+            int k = (n + 2) / 3, h = n - 2 * k;
+            return 8 * (k + 1) + std::max(std::max(mul_n_scratch(k), mul_n_scratch(h)), mul_n_scratch(k + 1));
+        }
+
+        // r = x * y for n-limb operands, r holds 2n limbs, ws holds mul_n_scratch(n) limbs.
+        // x == y selects the squaring variant of every tier
+        static void mul_n(limb *r, const limb *x, const limb *y, int n, limb *ws) {
+            if (n <= L::karatsuba_threshold && x == y)
+                basecase_sqr(r, x, n);
+            else if (n <= L::karatsuba_threshold)
+                basecase_mul(r, x, n, y, n);
+            else if (n < L::toom3_threshold)
+                karatsuba_mul(r, x, y, n, ws);
+            else
+                toom3_mul(r, x, y, n, ws);
+        }
+
+        static void karatsuba_mul(limb *r, const limb *x, const limb *y, int n, limb *ws) {
+            int k = n / 2, h = n - k;
+            mul_n(r, x, y, k, ws);
+            mul_n(r + 2 * k, x + k, y + k, h, ws);
+
+            limb *sx = ws, *sy = ws + h + 1, *z1 = ws + 2 * (h + 1);
+            sx[h] = add(sx, x + k, h, x, k);
+            if (x == y)
+                sy = sx;
+            else
+                sy[h] = add(sy, y + k, h, y, k);
+            mul_n(z1, sx, sy, h + 1, ws + 4 * (h + 1));
+            sub(z1, z1, 2 * (h + 1), r, 2 * k);
+            sub(z1, z1, 2 * (h + 1), r + 2 * k, 2 * h);
+            // the middle product is below base^(2h + 1), the limbs beyond the result are zero
+            add(r + k, r + k, 2 * n - k, z1, std::min(2 * (h + 1), 2 * n - k));
+        }
+
+        // r = |x0 - x1 + x2| in k + 1 limbs, returns the sign of x0 - x1 + x2
+        static int toom3_eval_m1(limb *r, const limb *x0, const limb *x1, const limb *x2, int k, int h) {
+            r[k] = add(r, x0, k, x2, h);
+            if (r[k] || cmp(r, x1, k) >= 0) {
+                r[k] -= sub(r, r, k, x1, k);
+                return 1;
+            }
+            sub(r, x1, k, r, k);
+            return -1;
+        }
+
+        // r = x0 + 2 x1 + 4 x2 in k + 1 limbs
+        static void toom3_eval_2(limb *r, const limb *x0, const limb *x1, const limb *x2, int k, int h) {
+            std::copy(x2, x2 + h, r);
+            std::fill(r + h, r + k + 1, 0);
+            mul_1(r, r, k + 1, 2);
+            add(r, r, k + 1, x1, k);
+            mul_1(r, r, k + 1, 2);
+            add(r, r, k + 1, x0, k);
+        }
+
+        // Toom-3 with evaluation points 0, 1, -1, 2, infinity and Bodrato's interpolation,
+        // in which only the value at -1 can be negative
+        static void toom3_mul(limb *r, const limb *x, const limb *y, int n, limb *ws) {
+            int k = (n + 2) / 3, h = n - 2 * k, m = k + 1, l = 2 * m;
+            const limb *x0 = x, *x1 = x + k, *x2 = x + 2 * k;
+            const limb *y0 = y, *y1 = y + k, *y2 = y + 2 * k;
+            limb *v1 = ws, *vm1 = ws + l, *v2 = ws + 2 * l, *ex = ws + 3 * l, *ey = ex + m, *rest = ey + m;
+
+            // a square evaluates once and multiplies the value by itself
+            bool square = x == y;
+            if (square)
+                ey = ex;
+            ex[k] = add(ex, x0, k, x2, h);
+            ex[k] += add(ex, ex, k, x1, k);
+            if (!square) {
+                ey[k] = add(ey, y0, k, y2, h);
+                ey[k] += add(ey, ey, k, y1, k);
+            }
+            mul_n(v1, ex, ey, m, rest);
+            int sm1 = toom3_eval_m1(ex, x0, x1, x2, k, h);
+            sm1 = square ? 1 : sm1 * toom3_eval_m1(ey, y0, y1, y2, k, h);
+            mul_n(vm1, ex, ey, m, rest);
+            toom3_eval_2(ex, x0, x1, x2, k, h);
+            if (!square)
+                toom3_eval_2(ey, y0, y1, y2, k, h);
+            mul_n(v2, ex, ey, m, rest);
+            mul_n(r, x0, y0, k, rest);
+            mul_n(r + 4 * k, x2, y2, h, rest);
+            toom3_interpolate(r, v1, vm1, v2, sm1, n);
+        }
+
+        // toom3_mul with its five products spread over up to `threads` threads, each with its own scratch
+        static void toom3_mul_parallel(limb *r, const limb *x, const limb *y, int n, int threads) {
+            int k = (n + 2) / 3, h = n - 2 * k, m = k + 1, l = 2 * m, s = mul_n_scratch(m);
+            const limb *x0 = x, *x1 = x + k, *x2 = x + 2 * k;
+            const limb *y0 = y, *y1 = y + k, *y2 = y + 2 * k;
+            std::vector<limb> ws(3 * l + 6 * m + 5 * s);
+            limb *v1 = ws.data(), *vm1 = v1 + l, *v2 = vm1 + l, *e = v2 + l, *rest = e + 6 * m;
+            limb *ex1 = e, *exm1 = e + m, *ex2 = e + 2 * m, *ey1 = e + 3 * m, *eym1 = e + 4 * m, *ey2 = e + 5 * m;
+
+            bool square = x == y;
+            ex1[k] = add(ex1, x0, k, x2, h);
+            ex1[k] += add(ex1, ex1, k, x1, k);
+            int sm1 = toom3_eval_m1(exm1, x0, x1, x2, k, h);
+            toom3_eval_2(ex2, x0, x1, x2, k, h);
+            if (square) {
+                ey1 = ex1, eym1 = exm1, ey2 = ex2, sm1 = 1;
+            } else {
+                ey1[k] = add(ey1, y0, k, y2, h);
+                ey1[k] += add(ey1, ey1, k, y1, k);
+                sm1 *= toom3_eval_m1(eym1, y0, y1, y2, k, h);
+                toom3_eval_2(ey2, y0, y1, y2, k, h);
+            }
+            run_parallel(5, threads, [&](int i) {
+                limb *t = rest + i * s;
+                if (i == 0)
+                    mul_n(v1, ex1, ey1, m, t);
+                else if (i == 1)
+                    mul_n(vm1, exm1, eym1, m, t);
+                else if (i == 2)
+                    mul_n(v2, ex2, ey2, m, t);
+                else if (i == 3)
+                    mul_n(r, x0, y0, k, t);
+                else
+                    mul_n(r + 4 * k, x2, y2, h, t);
+            });
+            toom3_interpolate(r, v1, vm1, v2, sm1, n);
+        }
+
+        // calls f(0) ... f(count - 1) on up to `threads` threads, the calling thread included
+        template<typename F>
+        static void run_parallel(int count, int threads, F f) {
+            threads = std::max(1, std::min(threads, count));
+            std::vector<std::thread> pool;
+            for (int t = 1; t < threads; t++)
+                pool.emplace_back([&f, t, threads, count]() {
+                    for (int i = t; i < count; i += threads)
+                        f(i);
+                });
+            for (int i = 0; i < count; i += threads)
+                f(i);
+            for (std::thread &th : pool)
+                th.join();
+        }
+
+        // combines v0 and vinf, already in r, with v1, v(-1) and v2 of length 2k + 2; sm1 is the sign of v(-1)
+        static void toom3_interpolate(limb *r, limb *v1, limb *vm1, limb *v2, int sm1, int n) {
+            int k = (n + 2) / 3, h = n - 2 * k, l = 2 * k + 2;
+            std::fill(r + 2 * k, r + 4 * k, 0);
+            const limb *v0 = r, *vinf = r + 4 * k;
+
+            // v2 = (v2 - vm1) / 3, vm1 = (v1 - vm1) / 2
+            if (sm1 > 0) {
+                sub(v2, v2, l, vm1, l);
+                sub(vm1, v1, l, vm1, l);
+            } else {
+                add(v2, v2, l, vm1, l);
+                add(vm1, v1, l, vm1, l);
+            }
+            divrem_1(v2, v2, l, 3);
+            divrem_1(vm1, vm1, l, 2);
+            // v1 = v1 - v0, v2 = (v2 - v1) / 2 - 2 vinf, v1 = v1 - vm1 - vinf, vm1 = vm1 - v2
+            sub(v1, v1, l, v0, 2 * k);
+            sub(v2, v2, l, v1, l);
+            divrem_1(v2, v2, l, 2);
+            sub(v2, v2, l, vinf, 2 * h);
+            sub(v2, v2, l, vinf, 2 * h);
+            sub(v1, v1, l, vm1, l);
+            sub(v1, v1, l, vinf, 2 * h);
+            sub(vm1, vm1, l, v2, l);
+            // vm1, v1, v2 now hold the coefficients of base^k, base^2k and base^3k
+            add(r + k, r + k, 2 * n - k, vm1, std::min(l, 2 * n - k));
+            add(r + 2 * k, r + 2 * k, 2 * n - 2 * k, v1, std::min(l, 2 * n - 2 * k));
+            add(r + 3 * k, r + 3 * k, 2 * n - 3 * k, v2, std::min(l, 2 * n - 3 * k));
+        }
+
+        // three-prime NTT over digits of L::ntt_radix, exact while the transform fits L::ntt_max_digits
+        static void ntt_mul(limb *r, const limb *x, int xn, const limb *y, int yn, int threads = 1) {
+            if ((xn + yn) * L::ntt_digits > L::ntt_max_digits) {
+                if (xn < yn) {
+                    std::swap(x, y);
+                    std::swap(xn, yn);
+                }
+                int h = xn / 2;
+                std::vector<limb> hi(xn - h + yn);
+                if (threads > 1) {
+                    // the halves are independent, each takes its share of the threads
+                    int t1 = threads / 2, t2 = threads - t1;
+                    std::thread lo([=]() { ntt_mul(r, x, h, y, yn, t1); });
+                    ntt_mul(hi.data(), x + h, xn - h, y, yn, t2);
+                    lo.join();
+                } else {
+                    ntt_mul(r, x, h, y, yn);
+                    ntt_mul(hi.data(), x + h, xn - h, y, yn);
+                }
+                std::fill(r + h + yn, r + xn + yn, 0);
+                add(r + h, r + h, xn - h + yn, hi.data(), hi.size());
+                return;
+            }
+            const uint64 radix = L::ntt_radix;
+            const uint64 m1 = 2013265921, m2 = 469762049, m3 = 167772161;
+            const uint64 m1_inv_m2 = math::pow_mod(m1 % m2, m2 - 2, m2);
+            const uint64 m12_inv_m3 = math::pow_mod(m1 * m2 % m3, m3 - 2, m3);
+            const uint64 m12 = m1 * m2, m12_hi = m12 / radix, m12_lo = m12 % radix;
+
+            std::vector<uint32> dx(xn * L::ntt_digits), dy(yn * L::ntt_digits);
+            for (int i = 0; i < (int) dx.size(); i++)
+                dx[i] = uint32(uint64(x[i / L::ntt_digits] >> (i % L::ntt_digits * 32)) % radix);
+            for (int i = 0; i < (int) dy.size(); i++)
+                dy[i] = uint32(uint64(y[i / L::ntt_digits] >> (i % L::ntt_digits * 32)) % radix);
+
+            int n = 1;
+            while (n < (int) (dx.size() + dy.size()))
+                n *= 2;
+            const std::vector<uint32> &dy1 = x == y && xn == yn ? dx : dy;
+            std::vector<uint32> r1, r2, r3;
+            // the three transforms share nothing but their read-only inputs
+            run_parallel(3, threads, [&](int i) {
+                if (i == 0)
+                    r1 = __ntt_prime1::convolve(dx, dy1, n);
+                else if (i == 1)
+                    r2 = __ntt_prime2::convolve(dx, dy1, n);
+                else
+                    r3 = __ntt_prime3::convolve(dx, dy1, n);
+            });
+
+            std::fill(r, r + xn + yn, 0);
+            uint64 carry = 0;
+            for (int i = 0; i < (int) (dx.size() + dy.size()); i++) {
+                uint64 v1 = r1[i];
+                uint64 v2 = (r2[i] + m2 - v1 % m2) * m1_inv_m2 % m2;
+                uint64 v12 = v1 + m1 * v2;
+                uint64 v3 = (r3[i] + m3 - v12 % m3) * m12_inv_m3 % m3;
+                // coefficient is v12 + m12 * v3, split so that every step fits in 64 bits
+                uint64 cur = v12 + m12_lo * v3 + carry;
+                r[i / L::ntt_digits] |= limb(cur % radix) << (i % L::ntt_digits * 32);
+                carry = cur / radix + m12_hi * v3;
+            }
+        }
+
+        static int mul_scratch(int xn, int yn) {
+            if (xn > yn)
+                std::swap(xn, yn);
+            if (xn <= L::karatsuba_threshold || xn >= L::ntt_threshold)
+                return 0;
+            if (xn == yn)
+                return mul_n_scratch(xn);
+            int s = mul_n_scratch(xn);
+            if (yn % xn)
+                s = std::max(s, mul_scratch(yn % xn, xn));
+            return 2 * xn + s;
+        }
+
+        // r = x * y, r holds xn + yn limbs and overlaps neither operand, ws holds mul_scratch(xn, yn) limbs;
+        // with threads > 1 products of at least L::parallel_threshold limbs use up to that many threads
+        static void mul(limb *r, const limb *x, int xn, const limb *y, int yn, limb *ws, int threads = 1) {
+            if (xn > yn) {
+                std::swap(x, y);
+                std::swap(xn, yn);
+            }
+            if (threads > 1 && yn >= L::parallel_threshold) {
+                mul_parallel(r, x, xn, y, yn, ws, threads);
+            } else if (xn <= L::karatsuba_threshold) {
+                if (x == y && xn == yn)
+                    basecase_sqr(r, x, xn);
+                else
+                    basecase_mul(r, x, xn, y, yn);
+            } else if (xn >= L::ntt_threshold) {
+                ntt_mul(r, x, xn, y, yn);
+            } else if (xn == yn) {
+                mul_n(r, x, y, xn, ws);
+            } else {
+                // the longer operand is cut into xn-limb pieces, each a balanced product
+                limb *t = ws;
+                mul_n(r, x, y, xn, ws + 2 * xn);
+                for (int i = xn; i < yn; i += xn) {
+                    int len = std::min(xn, yn - i);
+                    if (len == xn)
+                        mul_n(t, x, y + i, xn, ws + 2 * xn);
+                    else
+                        mul(t, y + i, len, x, xn, ws + 2 * xn);
+                    add(r + i, t, xn + len, r + i, xn);
+                }
+            }
+        }
+
+        // mul for xn <= yn, yn >= L::parallel_threshold and threads > 1; the limbs written are exactly the serial ones
+        static void mul_parallel(limb *r, const limb *x, int xn, const limb *y, int yn, limb *ws, int threads) {
+            if (xn >= L::ntt_threshold) {
+                ntt_mul(r, x, xn, y, yn, threads);
+            } else if (xn == yn && xn >= L::toom3_threshold) {
+                toom3_mul_parallel(r, x, y, xn, threads);
+            } else if (yn >= 2 * xn) {
+                // the longer operand is cut into one run of whole xn-limb pieces per thread
+                int pieces = std::min(threads, yn / xn), step = yn / xn / pieces * xn;
+                std::vector<std::vector<limb>> part(pieces);
+                run_parallel(pieces, threads, [&](int i) {
+                    int begin = i * step, len = i + 1 < pieces ? step : yn - begin;
+                    part[i].resize(xn + len + mul_scratch(xn, len));
+                    mul(part[i].data(), x, xn, y + begin, len, part[i].data() + xn + len);
+                });
+                std::fill(r, r + xn + yn, 0);
+                for (int i = 0; i < pieces; i++) {
+                    int len = i + 1 < pieces ? step : yn - i * step;
+                    add(r + i * step, r + i * step, xn + yn - i * step, part[i].data(), xn + len);
+                }
+            } else {
+                mul(r, x, xn, y, yn, ws);
+            }
+        }
+
+        static int mulhigh_scratch(int n) {
+            if (n <= L::karatsuba_threshold || n >= L::ntt_threshold)
+                return 0;
+            int l = n / 3, k = n - l;
+            return std::max(mul_scratch(k, k), 2 * l + mulhigh_scratch(l));
+        }
+
+        // short product of n-limb operands after Mulders: r[n, 2n) is at most 2n below floor(x y / base^n),
+        // r[0, n) is unspecified. The top 2/3 of the limbs multiply in full, the two remaining corners
+        // recurse, so the cost is a fraction of mul_n; ws holds mulhigh_scratch(n) limbs
+        static void mulhigh_n(limb *r, const limb *x, const limb *y, int n, limb *ws) {
+            if (n <= L::karatsuba_threshold) {
+                // the vector kernel computes the full product faster than the scalar rows compute half
+                if (__decimal_simd::basecase_mul(r, x, n, y, n))
+                    return;
+                std::fill(r, r + 2 * n, 0);
+                for (int i = 0; i < n; i++) {
+                    int j = std::max(0, n - 1 - i);
+                    r[i + n] = addmul_1(r + i + j, y + j, n - j, x[i]);
+                }
+                return;
+            }
+            if (n >= L::ntt_threshold) {
+                mul(r, x, n, y, n, ws);
+                return;
+            }
+            int l = n / 3, k = n - l;
+            std::fill(r, r + 2 * l, 0);
+            mul(r + 2 * l, x + l, k, y + l, k, ws);
+            limb *t = ws;
+            mulhigh_n(t, x + k, y, l, ws + 2 * l);
+            add(r + n, r + n, n, t + l, l);
+            mulhigh_n(t, y + k, x, l, ws + 2 * l);
+            add(r + n, r + n, n, t + l, l);
+        }
+    };
+
+    // a fixed int divisor for repeated bigint /= and %, with its reciprocal computed once
+    template<typename L>
+    struct basic_int_divisor {
+        typename __mpn<L>::divisor d;
+        int sign;
+
+        basic_int_divisor(int v) :
+                d(typename L::limb(v < 0 ? -(int64) v : v)), sign(v < 0 ? -1 : 1) {
+        }
+    };
+
+    template<typename L>
+    struct basic_bigint {
+        typedef typename L::limb limb;
+        typedef typename L::dlimb dlimb;
+        typedef __small_vector<limb, L::inline_limbs> limbs;
+        typedef __mpn<L> K;
+
+        limbs a;
+        int sign;
+
+        basic_bigint() :
+                sign(1) {
+        }
+
+        basic_bigint(long long v) {
+            *this = v;
+        }
+
+        basic_bigint(const std::string &s) {
+            read(s);
+        }
+
+        basic_bigint(const basic_bigint &v) = default;
+
+        basic_bigint(basic_bigint &&v) = default;
+
+        basic_bigint& operator=(const basic_bigint &v) = default;
+
+        basic_bigint& operator=(basic_bigint &&v) = default;
+
+        basic_bigint& operator=(long long v) {
+            sign = 1;
+            a.clear();
+            uint64 u = v;
+            if (v < 0)
+                sign = -1, u = -u;
+            for (; u > 0; u = uint64(L::high(u)))
+                a.push_back(L::low(u));
+            return *this;
+        }
+
+        static int cmp_abs(const limbs &x, const limbs &y) {
+            if (x.size() != y.size())
+                return x.size() < y.size() ? -1 : 1;
+            return K::cmp(x.data(), y.data(), x.size());
+        }
+
+        // x + sign_y * |y|
+        static basic_bigint add_signed(const basic_bigint &x, const basic_bigint &y, int sign_y) {
+            basic_bigint res;
+            int n = x.a.size(), m = y.a.size();
+            if (x.sign == sign_y) {
+                const limbs &lng = n >= m ? x.a : y.a, &sht = n >= m ? y.a : x.a;
+                res.a.resize(lng.size() + 1);
+                res.a.back() = K::add(res.a.data(), lng.data(), lng.size(), sht.data(), sht.size());
+                res.sign = x.sign;
+            } else if (cmp_abs(x.a, y.a) >= 0) {
+                res.a.resize(n);
+                K::sub(res.a.data(), x.a.data(), n, y.a.data(), m);
+                res.sign = x.sign;
+            } else {
+                res.a.resize(m);
+                K::sub(res.a.data(), y.a.data(), m, x.a.data(), n);
+                res.sign = sign_y;
+            }
+            res.trim();
+            return res;
+        }
+
+        basic_bigint operator+(const basic_bigint &v) const {
+            return add_signed(*this, v, v.sign);
+        }
+
+        basic_bigint operator-(const basic_bigint &v) const {
+            return add_signed(*this, v, -v.sign);
+        }
+
+        void operator*=(int v) {
+            if (v < 0)
+                sign = -sign;
+            uint64 m = v < 0 ? -(int64) v : v;
+            if (m >= L::base()) {
+                *this = *this * basic_bigint((long long) m);
+                return;
+            }
+            limb carry = K::mul_1(a.data(), a.data(), a.size(), limb(m));
+            if (carry)
+                a.push_back(carry);
+            trim();
+        }
+
+        basic_bigint operator*(int v) const {
+            basic_bigint res = *this;
+            res *= v;
+            return res;
+        }
+
+        // Knuth's algorithm D. v must be normalized (v.back() >= base / 2);
+        // u is replaced by the remainder and q receives u.size() - v.size() + 1 limbs
+        static void schoolbook_divmod(limbs &u, const limbs &v, limbs &q) {
+            u.push_back(0);
+            q.assign(u.size() - v.size(), 0);
+            K::divrem(q.data(), u.data(), u.size(), v.data(), v.size());
+            u.resize(v.size());
+        }
+
+        // multiplies by base^k, negative k drops the lowest limbs
+        basic_bigint shift_limbs(int k) const {
+            basic_bigint res;
+            res.sign = sign;
+            if (k >= 0) {
+                if (!a.empty()) {
+                    res.a.assign(k, 0);
+                    res.a.insert(res.a.end(), a.begin(), a.end());
+                }
+            } else if (-k < (int) a.size()) {
+                res.a.assign(a.begin() - k, a.end());
+            }
+            res.trim();
+            return res;
+        }
+
+        // floor((base^(2n) - 1) / v) for a normalized n-limb v, by Newton iteration down to threshold limbs
+        static basic_bigint reciprocal(const basic_bigint &v, int threshold = L::division_threshold) {
+            int n = v.a.size();
+            basic_bigint x;
+            if (n < threshold) {
+                limbs u(2 * n, limb(L::base() - 1));
+                schoolbook_divmod(u, v.a, x.a);
+                x.trim();
+                return x;
+            }
+            // the reciprocal xh of the leading h limbs gives about h correct limbs; one Newton step on
+            // base^(n - h) * xh doubles that, multiplying by xh itself rather than its shifted copy
+            int h = n / 2 + 1;
+            basic_bigint xh = reciprocal(v.shift_limbs(h - n), threshold), one(1);
+            basic_bigint e = one.shift_limbs(n + h) - v * xh;
+            x = xh.shift_limbs(n - h) + (xh * e.shift_limbs(1 - h)).shift_limbs(-h - 1);
+            basic_bigint r = one.shift_limbs(2 * n) - one - v * x;
+            while (r.sign < 0)
+                x -= one, r += v;
+            while (r >= v)
+                x += one, r -= v;
+            return x;
+        }
+
+        // u, v nonnegative, v normalized; quotient and remainder by a precomputed reciprocal
+        static void newton_divmod(const basic_bigint &u, const basic_bigint &v, basic_bigint &q, basic_bigint &r,
+                                  int threshold = L::division_threshold) {
+            int n = v.a.size(), m = u.a.size() - n;
+            if (m + 2 < n) {
+                // a short quotient only depends on the leading limbs of both operands
+                int s = n - m - 2;
+                basic_bigint rt;
+                newton_divmod(u.shift_limbs(-s), v.shift_limbs(-s), q, rt, threshold);
+                r = u - q * v;
+                while (r.sign < 0)
+                    q -= 1, r += v;
+                while (r >= v)
+                    q += 1, r -= v;
+                return;
+            }
+            basic_bigint x = reciprocal(v, threshold);
+            int t = (u.a.size() + n - 1) / n;
+            q.a.assign(t * n, 0);
+            r = basic_bigint();
+            for (int i = t - 1; i >= 0; i--) {
+                basic_bigint cur = r.shift_limbs(n);
+                int hi = std::min((int) u.a.size(), (i + 1) * n);
+                cur.a.resize(std::max(cur.a.size(), (size_t) n));
+                std::copy(u.a.begin() + i * n, u.a.begin() + hi, cur.a.begin());
+                cur.trim();
+                basic_bigint qi = (cur.shift_limbs(1 - n) * x).shift_limbs(-n - 1);
+                r = cur - qi * v;
+                while (r.sign < 0)
+                    qi -= 1, r += v;
+                while (r >= v)
+                    qi += 1, r -= v;
+                std::copy(qi.a.begin(), qi.a.end(), q.a.begin() + i * n);
+            }
+            q.trim();
+        }
+
+        friend std::pair<basic_bigint, basic_bigint> divmod(const basic_bigint &a1, const basic_bigint &b1) {
+            basic_bigint q, r;
+            int un = a1.a.size(), n = b1.a.size();
+            if (un < n) {
+                r = a1;
+            } else if (n == 1) {
+                q.a.resize(un);
+                r.a.assign(1, K::divrem_1(q.a.data(), a1.a.data(), un, b1.a[0]));
+            } else {
+                limb f = K::normalizer(b1.a.back());
+                basic_bigint a, b;
+                a.a.resize(un + 1);
+                b.a.resize(n);
+                a.a[un] = K::normalize(a.a.data(), a1.a.data(), un, f);
+                K::normalize(b.a.data(), b1.a.data(), n, f);
+                if (std::min(n, un - n + 1) < L::division_threshold) {
+                    q.a.assign(un + 1 - n, 0);
+                    K::divrem(q.a.data(), a.a.data(), un + 1, b.a.data(), n);
+                    r.a.resize(n);
+                    K::denormalize(r.a.data(), a.a.data(), n, f);
+                } else {
+                    a.trim();
+                    newton_divmod(a, b, q, r);
+                    if (!r.a.empty())
+                        K::denormalize(r.a.data(), r.a.data(), r.a.size(), f);
+                }
+            }
+            q.sign = a1.sign * b1.sign;
+            r.sign = a1.sign;
+            q.trim();
+            r.trim();
+            return std::make_pair(q, r);
+        }
+
+        basic_bigint operator/(const basic_bigint &v) const {
+            return divmod(*this, v).first;
+        }
+
+        basic_bigint operator%(const basic_bigint &v) const {
+            return divmod(*this, v).second;
+        }
+
+        void operator/=(int v) {
+            if (v < 0)
+                sign = -sign;
+            K::divrem_1(a.data(), a.data(), a.size(), limb(v < 0 ? -(int64) v : v));
+            trim();
+        }
+
+        basic_bigint operator/(int v) const {
+            basic_bigint res = *this;
+            res /= v;
+            return res;
+        }
+
+        int operator%(int v) const {
+            limb d = v < 0 ? -(int64) v : v;
+            return int(K::mod_1(a.data(), a.size(), d)) * sign;
+        }
+
+        void operator/=(const basic_int_divisor<L> &v) {
+            sign *= v.sign;
+            v.d.divrem(a.data(), a.data(), a.size());
+            trim();
+        }
+
+        basic_bigint operator/(const basic_int_divisor<L> &v) const {
+            basic_bigint res = *this;
+            res /= v;
+            return res;
+        }
+
+        int operator%(const basic_int_divisor<L> &v) const {
+            return int(v.d.divrem(nullptr, a.data(), a.size())) * sign;
+        }
+
+        // v % m[i] for every nonzero int m[i], with the sign of v as operator%(int) gives it. A remainder
+        // tree: moduli are packed into single limbs, multiplied up a product tree, and v is reduced
+        // down it, so the cost is a few multiplications of v's size rather than one pass per modulus
+        friend std::vector<int> remainders(const basic_bigint &v, const std::vector<int> &m) {
+            std::vector<int> res(m.size());
+            if (m.empty())
+                return res;
+            // leaves: runs of moduli whose product fits a limb, or single moduli that do not
+            std::vector<int> first;
+            std::vector<std::vector<basic_bigint>> tree(1);
+            dlimb pack = L::base();
+            for (int i = 0; i < (int) m.size(); i++) {
+                dlimb d = m[i] < 0 ? -(int64) m[i] : m[i];
+                if (pack >= L::base() || pack * d >= L::base()) {
+                    first.push_back(i);
+                    tree[0].push_back(basic_bigint());
+                    pack = 1;
+                }
+                pack *= d;
+                basic_bigint &leaf = tree[0].back();
+                leaf.a.clear();
+                leaf.a.push_back(L::low(pack));
+                leaf.a.push_back(limb(L::high(pack)));
+                leaf.trim();
+            }
+            first.push_back(m.size());
+            while (tree.back().size() > 1) {
+                const std::vector<basic_bigint> &low = tree.back();
+                std::vector<basic_bigint> up((low.size() + 1) / 2);
+                for (size_t i = 0; i < up.size(); i++)
+                    up[i] = 2 * i + 1 < low.size() ? low[2 * i] * low[2 * i + 1] : low[2 * i];
+                tree.push_back(std::move(up));
+            }
+            std::vector<basic_bigint> rem(1, v.abs() % tree.back()[0]);
+            for (int level = (int) tree.size() - 2; level >= 0; level--) {
+                std::vector<basic_bigint> next(tree[level].size());
+                for (size_t i = 0; i < next.size(); i++)
+                    next[i] = rem[i / 2] < tree[level][i] ? rem[i / 2] : rem[i / 2] % tree[level][i];
+                rem.swap(next);
+            }
+            for (size_t j = 0; j + 1 < first.size(); j++)
+                for (int i = first[j]; i < first[j + 1]; i++)
+                    res[i] = rem[j] % m[i] * v.sign;
+            return res;
+        }
+
+        // *this += sign_v * |v| in place, reusing the storage of *this
+        void add_signed(const basic_bigint &v, int sign_v) {
+            int n = a.size(), m = v.a.size();
+            if (a.empty()) {
+                a = v.a;
+                sign = sign_v;
+            } else if (sign == sign_v) {
+                if (n < m)
+                    a.resize(m);
+                limb carry = K::add(a.data(), a.data(), a.size(), v.a.data(), m);
+                if (carry)
+                    a.push_back(carry);
+            } else if (cmp_abs(a, v.a) >= 0) {
+                K::sub(a.data(), a.data(), n, v.a.data(), m);
+            } else {
+                a.resize(m);
+                K::sub(a.data(), v.a.data(), m, a.data(), n);
+                sign = sign_v;
+            }
+            trim();
+        }
+
+        void operator+=(const basic_bigint &v) {
+            add_signed(v, v.sign);
+        }
+
+        void operator-=(const basic_bigint &v) {
+            add_signed(v, -v.sign);
+        }
+
+        void operator*=(const basic_bigint &v) {
+            if (v.a.size() == 1 && this != &v) {
+                sign *= v.sign;
+                limb carry = K::mul_1(a.data(), a.data(), a.size(), v.a[0]);
+                if (carry)
+                    a.push_back(carry);
+                trim();
+                return;
+            }
+            // small products land in the inline buffer and are copied over the current storage
+            a = multiply(a, v.a);
+            sign *= v.sign;
+            trim();
+        }
+
+        void operator/=(const basic_bigint &v) {
+            if (v.a.size() == 1 && this != &v) {
+                sign *= v.sign;
+                K::divrem_1(a.data(), a.data(), a.size(), v.a[0]);
+                trim();
+                return;
+            }
+            *this = divmod(*this, v).first;
+        }
+
+        // *this += b * c without materializing the product when one factor is a single limb
+        // or the product is small enough for the schoolbook rows
+        void add_mul(const basic_bigint &b, const basic_bigint &c) {
+            if (b.is_zero() || c.is_zero())
+                return;
+            int s = b.sign * c.sign;
+            if (this == &b || this == &c || (!a.empty() && sign != s)
+                    || std::min(b.a.size(), c.a.size()) > L::karatsuba_threshold) {
+                *this += b * c;
+                return;
+            }
+            if (a.empty())
+                sign = s;
+            const limbs &x = b.a.size() >= c.a.size() ? b.a : c.a;
+            const limbs &y = b.a.size() >= c.a.size() ? c.a : b.a;
+            int xn = x.size();
+            a.resize(std::max(a.size(), x.size() + y.size()) + 1);
+            for (int i = 0; i < (int) y.size(); i++) {
+                limb carry = K::addmul_1(a.data() + i, x.data(), xn, y[i]);
+                K::add_1(a.data() + i + xn, a.data() + i + xn, a.size() - i - xn, carry);
+            }
+            trim();
+        }
+
+        bool operator<(const basic_bigint &v) const {
+            if (sign != v.sign)
+                return sign < v.sign;
+            int c = cmp_abs(a, v.a);
+            return sign > 0 ? c < 0 : c > 0;
+        }
+
+        bool operator>(const basic_bigint &v) const {
+            return v < *this;
+        }
+
+        bool operator<=(const basic_bigint &v) const {
+            return !(v < *this);
+        }
+
+        bool operator>=(const basic_bigint &v) const {
+            return !(*this < v);
+        }
+
+        bool operator==(const basic_bigint &v) const {
+            return !(*this < v) && !(v < *this);
+        }
+
+        bool operator!=(const basic_bigint &v) const {
+            return *this < v || v < *this;
+        }
+
+        void trim() {
+            while (!a.empty() && !a.back())
+                a.pop_back();
+            if (a.empty())
+                sign = 1;
+        }
+
+        bool is_zero() const {
+            return a.empty() || (a.size() == 1 && !a[0]);
+        }
+
+        basic_bigint operator-() const {
+            basic_bigint res = *this;
+            if (!res.a.empty())
+                res.sign = -sign;
+            return res;
+        }
+
+        basic_bigint abs() const {
+            basic_bigint res = *this;
+            res.sign *= res.sign;
+            return res;
+        }
+
+        long long long_value() const {
+            uint64 res = 0;
+            for (int i = (int) a.size() - 1; i >= 0; i--)
+                res = uint64((dlimb) res * L::base() + a[i]);
+            return (long long) res * sign;
+        }
+
+        // 2x2 matrix [[a, b], [c, d]] of nonnegative entries with determinant det = +-1, recording
+        // the Euclidean steps that took (x, y) to (x', y') as (x, y) = m (x', y')
+        struct gcd_matrix {
+            basic_bigint a, b, c, d;
+            int det;
+
+            gcd_matrix() :
+                    a(1), b(0), c(0), d(1), det(1) {
+            }
+
+            gcd_matrix(const basic_bigint &a, const basic_bigint &b, const basic_bigint &c, const basic_bigint &d, int det) :
+                    a(a), b(b), c(c), d(d), det(det) {
+            }
+
+            // this = this * n
+            void mul(const gcd_matrix &n) {
+                basic_bigint na = a * n.a + b * n.c, nb = a * n.b + b * n.d;
+                basic_bigint nc = c * n.a + d * n.c, nd = c * n.b + d * n.d;
+                a = std::move(na), b = std::move(nb), c = std::move(nc), d = std::move(nd);
+                det *= n.det;
+            }
+
+            // this = this * [[p, q], [r, s]] for single-limb entries
+            void mul(limb p, limb q, limb r, limb s, int ndet) {
+                mul_row(a, b, p, q, r, s);
+                mul_row(c, d, p, q, r, s);
+                det *= ndet;
+            }
+
+            // (u, v) = (u p + v r, u q + v s)
+            static void mul_row(basic_bigint &u, basic_bigint &v, limb p, limb q, limb r, limb s) {
+                int len = std::max(u.a.size(), v.a.size()) + 1;
+                u.a.resize(len);
+                v.a.resize(len);
+                basic_bigint nu, nv;
+                nu.a.resize(len);
+                nv.a.resize(len);
+                K::mul_1(nu.a.data(), u.a.data(), len, p);
+                K::mul_1(nv.a.data(), u.a.data(), len, q);
+                limb carry = K::addmul_1(nu.a.data(), v.a.data(), len, r);
+                if (carry)
+                    nu.a.push_back(carry);
+                carry = K::addmul_1(nv.a.data(), v.a.data(), len, s);
+                if (carry)
+                    nv.a.push_back(carry);
+                nu.trim();
+                nv.trim();
+                u = std::move(nu), v = std::move(nv);
+            }
+
+            // this = this * [[q, 1], [1, 0]]
+            void mul_quotient(const basic_bigint &q) {
+                basic_bigint na = a * q + b, nc = c * q + d;
+                b = std::move(a), d = std::move(c);
+                a = std::move(na), c = std::move(nc);
+                det = -det;
+            }
+
+            // (x, y) = this^-1 (x, y); fails, leaving x and y untouched, on a negative result
+            bool apply_inverse(basic_bigint &x, basic_bigint &y) const {
+                basic_bigint nx = d * x - b * y, ny = a * y - c * x;
+                if (det < 0)
+                    nx = -nx, ny = -ny;
+                if (nx.sign < 0 || ny.sign < 0)
+                    return false;
+                x = std::move(nx), y = std::move(ny);
+                return true;
+            }
+        };
+
+        // (x, y) = (y, x mod y)
+        static void euclid_step(basic_bigint &x, basic_bigint &y, gcd_matrix *m) {
+            std::pair<basic_bigint, basic_bigint> qr = divmod(x, y);
+            if (m)
+                m->mul_quotient(qr.first);
+            x = std::move(y);
+            y = std::move(qr.second);
+        }
+
+        // p x + q y >= 0 for |p|, |q| < base of opposite signs, y no longer than x
+        static basic_bigint combine(const basic_bigint &x, const basic_bigint &y, __int128 p, __int128 q) {
+            int n = x.a.size(), k = y.a.size();
+            basic_bigint res;
+            res.a.resize(n + 1);
+            if (q <= 0) {
+                res.a[n] = K::mul_1(res.a.data(), x.a.data(), n, limb(p));
+                limb borrow = K::submul_1(res.a.data(), y.a.data(), k, limb(-q));
+                if (k < n)
+                    borrow = K::sub_1(res.a.data() + k, res.a.data() + k, n - k, borrow);
+                res.a[n] -= borrow;
+            } else {
+                res.a[k] = K::mul_1(res.a.data(), y.a.data(), k, limb(q));
+                res.a[n] -= K::submul_1(res.a.data(), x.a.data(), n, limb(-p));
+            }
+            res.trim();
+            return res;
+        }
+
+        // Lehmer's step for x >= y of about the same length: Euclid's algorithm runs on the leading
+        // two limbs for as long as their quotients are certain (Knuth 4.5.2, algorithm L), then the
+        // single-limb cofactors are applied to x and y. Returns false if no quotient was certain
+        static bool lehmer_step(basic_bigint &x, basic_bigint &y, gcd_matrix *m) {
+            int n = x.a.size();
+            if (n < 2 || (int) y.a.size() < n - 1)
+                return false;
+            dlimb xh = (dlimb) x.a[n - 1] * L::base() + x.a[n - 2];
+            dlimb yh = ((int) y.a.size() == n ? (dlimb) y.a[n - 1] * L::base() : 0) + y.a[n - 2];
+            if (!L::decimal) {
+                // keep the leading 62 bits so that the cofactor arithmetic below cannot overflow
+                int s = 66 - __builtin_clzll(uint64(x.a[n - 1]));
+                xh >>= s;
+                yh >>= s;
+            }
+            const __int128 limit = L::decimal ? __int128(L::base()) : __int128(1) << 62;
+            __int128 u = xh, v = yh, A = 1, B = 0, C = 0, D = 1;
+            while (v + C != 0 && v + D != 0) {
+                __int128 q = (u + A) / (v + C);
+                if (q != (u + B) / (v + D))
+                    break;
+                __int128 nc = A - q * C, nd = B - q * D;
+                if (nc >= limit || -nc >= limit || nd >= limit || -nd >= limit)
+                    break;
+                A = C, B = D, C = nc, D = nd;
+                __int128 t = u - q * v;
+                u = v, v = t;
+            }
+            if (B == 0)
+                return false;
+            basic_bigint nx = combine(x, y, A, B), ny = combine(x, y, C, D);
+            if (m) {
+                // (x, y) = [[A, B], [C, D]]^-1 (x', y')
+                int det = A * D - B * C > 0 ? 1 : -1;
+                m->mul(limb(det * D), limb(-det * B), limb(-det * C), limb(det * A), det);
+            }
+            x = std::move(nx), y = std::move(ny);
+            return true;
+        }
+
+        static void gcd_step(basic_bigint &x, basic_bigint &y, gcd_matrix *m) {
+            if (!lehmer_step(x, y, m))
+                euclid_step(x, y, m);
+        }
+
+        // half-GCD: runs the Euclidean algorithm on x >= y until y has at most s limbs, recording
+        // the steps in m. Above L::hgcd_threshold the leading halves are reduced recursively and
+        // the resulting matrices applied to the full numbers, as in Thull and Yap's algorithm
+        static void hgcd(basic_bigint &x, basic_bigint &y, int s, gcd_matrix &m) {
+            m = gcd_matrix();
+            int n = x.a.size();
+            if (n - s >= L::hgcd_threshold && (int) y.a.size() > s) {
+                // the leading n - s limbs reduced to half their length, with two limbs to spare
+                // so that the truncated low parts cannot change the quotients
+                basic_bigint xh = x.shift_limbs(-s), yh = y.shift_limbs(-s);
+                gcd_matrix m1;
+                hgcd(xh, yh, (n - s) / 2 + 2, m1);
+                if (m1.apply_inverse(x, y))
+                    m = std::move(m1);
+                n = x.a.size();
+                if (2 * s > n && (int) y.a.size() > s) {
+                    int p = 2 * s - n;
+                    xh = x.shift_limbs(-p), yh = y.shift_limbs(-p);
+                    gcd_matrix m2;
+                    hgcd(xh, yh, s - p + 2, m2);
+                    if (m2.apply_inverse(x, y))
+                        m.mul(m2);
+                }
+            }
+            while ((int) y.a.size() > s)
+                gcd_step(x, y, &m);
+        }
+
+        // gcd of x, y >= 0; records the steps in m when given
+        static basic_bigint gcd_core(basic_bigint x, basic_bigint y, gcd_matrix *m) {
+            if (cmp_abs(x.a, y.a) < 0) {
+                std::swap(x, y);
+                if (m)
+                    m->mul(gcd_matrix(0, 1, 1, 0, -1));
+            }
+            while (!y.is_zero()) {
+                int n = x.a.size(), k = y.a.size();
+                if (k >= L::hgcd_threshold && 2 * k > n + 2) {
+                    gcd_matrix h;
+                    hgcd(x, y, n / 2, h);
+                    if (m)
+                        m->mul(h);
+                } else {
+                    gcd_step(x, y, m);
+                }
+            }
+            return x;
+        }
+
+        friend basic_bigint gcd(const basic_bigint &a, const basic_bigint &b) {
+            return gcd_core(a.abs(), b.abs(), nullptr);
+        }
+
+        // g = gcd(a, b) = a x + b y
+        friend basic_bigint gcdext(const basic_bigint &a, const basic_bigint &b, basic_bigint &x, basic_bigint &y) {
+            gcd_matrix m;
+            basic_bigint g = gcd_core(a.abs(), b.abs(), &m);
+            // (|a|, |b|) = m (g, 0), so g = det (d |a| - b |b|)
+            x = m.det > 0 ? m.d : -m.d;
+            y = m.det > 0 ? -m.b : m.b;
+            if (a.sign < 0)
+                x = -x;
+            if (b.sign < 0)
+                y = -y;
+            return g;
+        }
+
+        // x in [0, m) with a x = 1 (mod m), or 0 if a is not invertible
+        friend basic_bigint modinv(const basic_bigint &a, const basic_bigint &m) {
+            basic_bigint x, y, mod = m.abs();
+            if (!(gcdext(a % mod, mod, x, y) == basic_bigint(1)))
+                return basic_bigint();
+            x = x % mod;
+            if (x.sign < 0)
+                x += mod;
+            return x;
+        }
+
+        friend basic_bigint lcm(const basic_bigint &a, const basic_bigint &b) {
+            return a / gcd(a, b) * b;
+        }
+
+        basic_bigint sqr() const {
+            basic_bigint res;
+            res.a = multiply(a, a);
+            res.trim();
+            return res;
+        }
+
+        // sliding-window exponentiation over the bits of e; e <= 0 gives 1
+        template<typename E>
+        basic_bigint pow(E e) const {
+            basic_bigint res(1);
+            if (!(e > 0))
+                return res;
+            uint64 u = e;
+            int bits = 64 - __builtin_clzll(u);
+            int w = bits <= 6 ? 1 : bits <= 24 ? 2 : 3;
+            // odd powers x, x^3, ..., x^(2^w - 1)
+            std::vector<basic_bigint> odd(1 << (w - 1), *this);
+            if (w > 1) {
+                basic_bigint x2 = sqr();
+                for (int i = 1; i < (int) odd.size(); i++)
+                    odd[i] = odd[i - 1] * x2;
+            }
+            bool one = true;
+            for (int i = bits - 1; i >= 0;) {
+                if (!(u >> i & 1)) {
+                    res *= res;
+                    i--;
+                    continue;
+                }
+                int j = std::max(i - w + 1, 0);
+                while (!(u >> j & 1))
+                    j++;
+                for (int k = i; k >= j && !one; k--)
+                    res *= res;
+                if (one)
+                    res = odd[(u >> j & ((2ull << (i - j)) - 1)) >> 1];
+                else
+                    res *= odd[(u >> j & ((2ull << (i - j)) - 1)) >> 1];
+                one = false;
+                i = j - 1;
+            }
+            return res;
+        }
+
+        basic_bigint pow(const basic_bigint &e) const {
+            if (e.sign < 0 || e <= basic_bigint(LLONG_MAX))
+                return pow(e.long_value());
+            // only 0 and +-1 have powers this large that fit in memory
+            if (a.size() > 1 || (!a.empty() && a[0] != 1))
+                return pow(LLONG_MAX);
+            return sign < 0 && e % 2 ? *this : abs();
+        }
+
+        template<typename E>
+        basic_bigint operator^(const E &e) const {
+            return pow(e);
+        }
+
+        // limbs [lo, hi) as a nonnegative value
+        basic_bigint limb_range(int lo, int hi) const {
+            basic_bigint res;
+            hi = std::min(hi, (int) a.size());
+            if (lo < hi)
+                res.a.assign(a.begin() + lo, a.begin() + hi);
+            res.trim();
+            return res;
+        }
+
+        // Zimmermann's Karatsuba square root: n has at most 2h limbs and n >= base^(2h) / 4,
+        // s = floor(sqrt(n)) and r = n - s^2
+        static void sqrtrem(const basic_bigint &n, int h, basic_bigint &s, basic_bigint &r) {
+            if (h == 1) {
+                dlimb v = n.a.size() > 1 ? (dlimb) n.a[1] * L::base() + n.a[0] : n.a[0];
+                long double e = sqrtl((long double) v);
+                limb x = e >= (long double) (L::base() - 1) ? limb(L::base() - 1) : limb(e);
+                while ((dlimb) x * x > v)
+                    x--;
+                while ((dlimb) x + 1 < L::base() && ((dlimb) x + 1) * ((dlimb) x + 1) <= v)
+                    x++;
+                v -= (dlimb) x * x;
+                s = basic_bigint(), r = basic_bigint();
+                s.a.push_back(x);
+                r.a.push_back(L::low(v));
+                r.a.push_back(limb(L::high(v)));
+                s.trim();
+                r.trim();
+                return;
+            }
+            // n = a3 b^3 + a2 b^2 + a1 b + a0 with b = base^k; the top half gives s' and r', one division
+            // by 2 s' extends s' to the whole root and at most one correction follows
+            int k = h / 2;
+            basic_bigint s1, r1;
+            sqrtrem(n.limb_range(2 * k, 2 * h), h - k, s1, r1);
+            std::pair<basic_bigint, basic_bigint> qu = divmod(r1.shift_limbs(k) + n.limb_range(k, 2 * k), s1 * 2);
+            s = s1.shift_limbs(k) + qu.first;
+            r = qu.second.shift_limbs(k) + n.limb_range(0, k) - qu.first.sqr();
+            if (r.sign < 0) {
+                r += s * 2 - basic_bigint(1);
+                s -= basic_bigint(1);
+            }
+        }
+
+        // floor(sqrt(*this)), 0 for negative values. The value is scaled by g^2 into an even number of
+        // limbs with the top one at least base / 4, and floor(sqrt(v g^2)) / g = floor(sqrt(v))
+        basic_bigint isqrt() const {
+            if (sign < 0 || a.empty())
+                return basic_bigint();
+            int m = a.size(), n = m + m % 2;
+            const long double b = (long double) L::base();
+            long double top = (long double) a[m - 1] * b + (m > 1 ? a[m - 2] : 0);
+            long double want = powl(b, n - m + 2) / (4 * top);
+            limb g = want <= 1 ? 1 : limb(ceill(sqrtl(want)));
+            basic_bigint v;
+            for (;;) {
+                v.a.assign(a.begin(), a.end());
+                v.a.push_back(K::mul_1(v.a.data(), v.a.data(), m, g));
+                v.a.push_back(K::mul_1(v.a.data(), v.a.data(), m + 1, g));
+                v.trim();
+                // g comes from a floating estimate, step it until the scaled value is in range
+                if ((int) v.a.size() > n)
+                    g--;
+                else if ((int) v.a.size() < n || 4 * (dlimb) v.a.back() < L::base())
+                    g++;
+                else
+                    break;
+            }
+            basic_bigint s, r;
+            sqrtrem(v, n / 2, s, r);
+            K::divrem_1(s.a.data(), s.a.data(), s.a.size(), g);
+            s.trim();
+            return s;
+        }
+
+        // floor(n^(1/k)) for n > 0 and k >= 3 by Newton's iteration from an overestimate whose top
+        // half is the root of the top limbs, so only the last couple of steps run at full size
+        static basic_bigint iroot_newton(const basic_bigint &n, int k) {
+            int m = n.a.size(), t = ((m + k - 1) / k - 1) / 2;
+            basic_bigint x;
+            if (t > 0) {
+                x = (iroot_newton(n.shift_limbs(-k * t), k) + basic_bigint(1)).shift_limbs(t);
+            } else {
+                // the root is below base^2: a logarithm of the top limbs, nudged upwards, is close enough
+                const long double b = (long double) L::base();
+                long double top = 0;
+                for (int i = m - 1; i >= std::max(0, m - 3); i--)
+                    top = top * b + n.a[i];
+                long double e = expl((logl(top) + std::max(0, m - 3) * logl(b)) / k) * (1 + 1e-15L) + 2;
+                for (; e >= 1; e = floorl(e / b))
+                    x.a.push_back(limb(fmodl(e, b)));
+            }
+            // from above every Newton step stays at or above the root, so x^k <= n means x is the root
+            for (;;) {
+                basic_bigint p = x.pow(k - 1);
+                if (!(n < p * x))
+                    return x;
+                x = (x * (k - 1) + n / p) / k;
+            }
+        }
+
+        // floor(|v|^(1/k)) with the sign of v for k >= 1; an even root of a negative value is 0
+        basic_bigint iroot(int k) const {
+            if (a.empty() || k == 1)
+                return *this;
+            if (sign < 0 && k % 2 == 0)
+                return basic_bigint();
+            basic_bigint res = k == 2 ? isqrt() : iroot_newton(abs(), k);
+            if (sign < 0)
+                res = -res;
+            return res;
+        }
+
+        // whether |v| = x^k for an integer x and k >= 2, odd k for negative v; 0 and +-1 qualify
+        bool is_perfect_power() const {
+            if (a.empty() || (a.size() == 1 && a[0] == 1))
+                return true;
+            basic_bigint n = abs();
+            int bits = int(((long double) a.size() - 1) * log2l((long double) L::base()) + log2l((long double) a.back())) + 1;
+            // only prime exponents need trying. If a prime p < 1000 divides n, k divides the valuation of p;
+            // otherwise x > 1000 and k <= log_1000(n)
+            const int trial = 1000;
+            std::vector<int> small;
+            for (int p = 2; p < trial; p++)
+                if (math::is_prime(p))
+                    small.push_back(p);
+            std::vector<int> rs = remainders(n, small), exponents;
+            int p = 0;
+            for (int i = 0; i < (int) small.size() && !p; i++)
+                if (rs[i] == 0)
+                    p = small[i];
+            if (p) {
+                int e = valuation(n, p);
+                for (int k = 2; k <= e; k++)
+                    if (e % k == 0 && math::is_prime(k))
+                        exponents.push_back(k);
+            } else {
+                for (int k = 2; k <= bits / log2(trial); k++)
+                    if (math::is_prime(k))
+                        exponents.push_back(k);
+            }
+            if (sign < 0 && !exponents.empty() && exponents[0] == 2)
+                exponents.erase(exponents.begin());
+            // a k-th power is a k-th power residue modulo every prime q = 1 (mod k), which anything else is
+            // with chance about 1/k: three such primes for small k, one for large k leave a root to take
+            // only rarely. The residues for every k come from one remainder tree
+            std::vector<int> moduli, first;
+            for (int k : exponents) {
+                first.push_back(moduli.size());
+                for (int64 q = 2 * k + 1, found = 0; found < (k < 64 ? 3 : 1) && q < INT_MAX; q += 2 * k)
+                    if (math::is_prime(uint32(q)))
+                        moduli.push_back(int(q)), found++;
+            }
+            first.push_back(moduli.size());
+            std::vector<int> residues = remainders(n, moduli);
+            for (int i = 0; i < (int) exponents.size(); i++) {
+                int k = exponents[i];
+                bool residue = true;
+                for (int j = first[i]; j < first[i + 1] && residue; j++)
+                    residue = residues[j] == 0 || math::pow_mod(residues[j], (moduli[j] - 1) / k, moduli[j]) == 1;
+                if (residue && n.iroot(k).pow(k) == n)
+                    return true;
+            }
+            return false;
+        }
+
+        // the exponent of the prime p in v != 0: divisions by p^(2^i) going up while they divide, then down
+        static int valuation(basic_bigint v, int p) {
+            std::vector<basic_bigint> powers(1, basic_bigint(p));
+            int e = 0;
+            while (true) {
+                std::pair<basic_bigint, basic_bigint> qr = divmod(v, powers.back());
+                if (!qr.second.a.empty())
+                    break;
+                v = qr.first;
+                e += 1 << (powers.size() - 1);
+                powers.push_back(powers.back().sqr());
+            }
+            for (int i = (int) powers.size() - 2; i >= 0; i--) {
+                std::pair<basic_bigint, basic_bigint> qr = divmod(v, powers[i]);
+                if (qr.second.a.empty())
+                    v = qr.first, e += 1 << i;
+            }
+            return e;
+        }
+
+        // product tree leaves: small factors are packed into single limbs, the rest kept whole. Any builtin
+        // integer type up to 64 bits, unsigned ones above LLONG_MAX included
+        template<typename T>
+        static void push_factor(std::vector<basic_bigint> &f, dlimb &pack, int &sign, T x) {
+            bool negative = std::is_signed<T>::value && x < T(0);
+            if (negative)
+                sign = -sign;
+            uint64 u = negative ? -(uint64) x : (uint64) x;
+            if (u < L::base() && pack * u < L::base()) {
+                pack *= u;
+                return;
+            }
+            push_pack(f, pack);
+            if (u < L::base()) {
+                pack = u;
+                return;
+            }
+            f.push_back(basic_bigint());
+            for (; u > 0; u = uint64(L::high(u)))
+                f.back().a.push_back(L::low(u));
+        }
+
+        static void push_pack(std::vector<basic_bigint> &f, dlimb &pack) {
+            if (pack != 1) {
+                f.push_back(basic_bigint());
+                f.back().a.push_back(limb(pack));
+                f.back().trim();
+            }
+            pack = 1;
+        }
+
+        static void push_factor(std::vector<basic_bigint> &f, dlimb &, int &, const basic_bigint &x) {
+            f.push_back(x);
+        }
+
+        // multiplies neighbours pairwise until one value is left, so the large products are balanced
+        static basic_bigint product_tree(std::vector<basic_bigint> &f) {
+            if (f.empty())
+                return basic_bigint(1);
+            for (size_t len = f.size(); len > 1; len = (len + 1) / 2) {
+                for (size_t i = 0; i + 1 < len; i += 2)
+                    f[i / 2] = f[i] * f[i + 1];
+                if (len % 2)
+                    f[len / 2] = std::move(f[len - 1]);
+            }
+            return f[0];
+        }
+
+        // product of a range of integers or bigints through a balanced product tree
+        template<typename It>
+        static basic_bigint product(It first, It last) {
+            std::vector<basic_bigint> f;
+            dlimb pack = 1;
+            int sign = 1;
+            for (; first != last; ++first)
+                push_factor(f, pack, sign, *first);
+            push_pack(f, pack);
+            basic_bigint res = product_tree(f);
+            if (sign < 0)
+                res = -res;
+            return res;
+        }
+
+        static basic_bigint factorial(uint32 n) {
+            std::vector<basic_bigint> f;
+            dlimb pack = 1;
+            int sign = 1;
+            for (uint32 i = 2; i <= n; i++)
+                push_factor(f, pack, sign, i);
+            push_pack(f, pack);
+            return product_tree(f);
+        }
+
+        // C(n, k) as the product of the prime powers that Legendre's formula leaves in n! / (k! (n - k)!)
+        static basic_bigint binomial(uint32 n, uint32 k) {
+            if (k > n)
+                return basic_bigint();
+            k = std::min(k, n - k);
+            std::vector<bool> composite(n + 1);
+            std::vector<basic_bigint> f;
+            dlimb pack = 1;
+            int sign = 1;
+            for (uint64 p = 2; p <= n; p++) {
+                if (composite[p])
+                    continue;
+                for (uint64 j = p * p; j <= n; j += p)
+                    composite[j] = true;
+                int e = 0;
+                for (uint64 q = p; q <= n; q *= p)
+                    e += int(n / q - k / q - (n - k) / q);
+                for (; e > 0; e--)
+                    push_factor(f, pack, sign, p);
+            }
+            push_pack(f, pack);
+            return product_tree(f);
+        }
+
+        // binary splitting over [n1, n2) of the series sum a(n) p(n1) ... p(n) / (q(n1) ... q(n)):
+        // P and Q are the products of p and q and T / Q is the partial sum (P = Q = 1, T = 0 for an empty
+        // range). Halves combine as P = P1 P2, Q = Q1 Q2, T = T1 Q2 + P1 T2, so every level multiplies
+        // values of similar size
+        template<typename Fp, typename Fq, typename Fa>
+        static void binary_splitting(long long n1, long long n2, Fp p, Fq q, Fa a,
+                                     basic_bigint &P, basic_bigint &Q, basic_bigint &T) {
+            if (n2 <= n1) {
+                P = Q = basic_bigint(1);
+                T = basic_bigint();
+                return;
+            }
+            if (n2 - n1 == 1) {
+                P = basic_bigint(p(n1));
+                Q = basic_bigint(q(n1));
+                T = basic_bigint(a(n1)) * P;
+                return;
+            }
+            long long m = n1 + (n2 - n1) / 2;
+            basic_bigint P2, Q2, T2;
+            binary_splitting(n1, m, p, q, a, P, Q, T);
+            binary_splitting(m, n2, p, q, a, P2, Q2, T2);
+            T = T * Q2 + P * T2;
+            P *= P2;
+            Q *= Q2;
+        }
+
+        void read(const char *first, const char *last) {
+            int s = 1;
+            while (first < last && (*first == '-' || *first == '+')) {
+                if (*first == '-')
+                    s = -s;
+                ++first;
+            }
+            if (L::decimal) {
+                a.clear();
+                a.reserve((last - first) / bigint_base_digits + 1);
+                for (const char *i = last; i > first; i -= bigint_base_digits) {
+                    limb x = 0;
+                    for (const char *j = std::max(first, i - bigint_base_digits); j < i; j++)
+                        x = x * 10 + *j - '0';
+                    a.push_back(x);
+                }
+            } else {
+                *this = __decimal_conversion<basic_bigint>::read(first, last);
+            }
+            sign = s;
+            trim();
+        }
+
+        void read(const std::string &s) {
+            read(s.data(), s.data() + s.size());
+        }
+
+        // buffer size to_chars needs, sign included; exact for decimal limbs
+        int chars_length() const {
+            if (a.empty())
+                return 1;
+            if (!L::decimal)
+                return (sign == -1) + a.size() * 20;
+            int len = (sign == -1) + (a.size() - 1) * bigint_base_digits;
+            for (limb top = a.back(); top > 0; top /= 10)
+                len++;
+            return len;
+        }
+
+        // writes the decimal representation starting at buf, returns the end of the written range
+        char *to_chars(char *buf) const {
+            if (a.empty()) {
+                *buf = '0';
+                return buf + 1;
+            }
+            if (sign == -1)
+                *buf++ = '-';
+            if (!L::decimal)
+                return __decimal_conversion<basic_bigint>::write(abs(), buf);
+            char top[bigint_base_digits];
+            int len = 0;
+            for (limb x = a.back(); x > 0; x /= 10)
+                top[len++] = char('0' + x % 10);
+            while (len > 0)
+                *buf++ = top[--len];
+            for (int i = (int) a.size() - 2; i >= 0; i--, buf += bigint_base_digits)
+                math::write_nine_digits(buf, a[i]);
+            return buf;
+        }
+
+        friend std::istream &operator>>(std::istream &stream, basic_bigint &v) {
+            std::string s;
+            stream >> s;
+            v.read(s);
+            return stream;
+        }
+
+        friend std::ostream &operator<<(std::ostream &stream, const basic_bigint &v) {
+            char small[64];
+            int len = v.chars_length();
+            if (len <= (int) sizeof(small))
+                return stream.write(small, v.to_chars(small) - small);
+            std::vector<char> buf(len);
+            return stream.write(buf.data(), v.to_chars(buf.data()) - buf.data());
+        }
+
+#ifdef LINUX
+        // binary format, version 1: a 16-byte header of the magic "LBIG", the version as a little-endian
+        // uint16, the limb kind (0 for 10^9 in 4 bytes, 1 for 2^64 in 8 bytes), the sign as int8 and the
+        // limb count as a little-endian uint64, then the limbs least significant first, each little-endian
+        static const int file_header = 16;
+        static const uint16 file_version = 1;
+
+        static bool little_endian() {
+            return __BYTE_ORDER__ == __ORDER_LITTLE_ENDIAN__;
+        }
+
+        // the limbs in file byte order, which is the host's on little-endian machines
+        static void swap_limbs(limb *x, size_t n) {
+            if (!little_endian())
+                for (size_t i = 0; i < n; i++)
+                    x[i] = sizeof(limb) == 4 ? limb(__builtin_bswap32(uint32(x[i]))) : limb(__builtin_bswap64(uint64(x[i])));
+        }
+
+        static void write_header(char *h, int sign, uint64 n) {
+            std::copy("LBIG", "LBIG" + 4, h);
+            for (int i = 0; i < 2; i++)
+                h[4 + i] = char(file_version >> (8 * i));
+            h[6] = char(!L::decimal);
+            h[7] = char(sign);
+            for (int i = 0; i < 8; i++)
+                h[8 + i] = char(n >> (8 * i));
+        }
+
+        // false unless h is a version 1 header for this limb kind; n receives the limb count
+        static bool read_header(const char *h, int &sign, uint64 &n) {
+            if (!std::equal(h, h + 4, "LBIG") || (uint8(h[4]) | uint8(h[5]) << 8) != file_version || h[6] != char(!L::decimal))
+                return false;
+            sign = h[7] < 0 ? -1 : 1;
+            n = 0;
+            for (int i = 7; i >= 0; i--)
+                n = n << 8 | uint8(h[8 + i]);
+            return true;
+        }
+
+        static bool write_all(int fd, const char *p, size_t len) {
+            while (len > 0) {
+                ssize_t w = ::write(fd, p, len);
+                if (w < 0 && errno == EINTR)
+                    continue;
+                if (w <= 0)
+                    return false;
+                p += w, len -= w;
+            }
+            return true;
+        }
+
+        static bool read_all(int fd, char *p, size_t len) {
+            while (len > 0) {
+                ssize_t r = ::read(fd, p, len);
+                if (r < 0 && errno == EINTR)
+                    continue;
+                if (r <= 0)
+                    return false;
+                p += r, len -= r;
+            }
+            return true;
+        }
+
+        // writes the binary format to fd, false on a write error
+        bool save(int fd) const {
+            char h[file_header];
+            write_header(h, sign, a.size());
+            if (!write_all(fd, h, file_header))
+                return false;
+            if (little_endian())
+                return write_all(fd, (const char *) a.data(), a.size() * sizeof(limb));
+            limbs t = a;
+            swap_limbs(t.data(), t.size());
+            return write_all(fd, (const char *) t.data(), t.size() * sizeof(limb));
+        }
+
+        // reads the binary format from fd; false, leaving *this unchanged, on a read error, a foreign
+        // header or limbs out of range
+        bool load(int fd) {
+            char h[file_header];
+            int s;
+            uint64 n;
+            if (!read_all(fd, h, file_header) || !read_header(h, s, n))
+                return false;
+            // the count is trusted only as far as the data goes: a regular file must hold all the limbs, and
+            // anything else is read in growing chunks, so a corrupt count fails at the end of the input
+            struct stat st;
+            off_t pos;
+            if (fstat(fd, &st) == 0 && S_ISREG(st.st_mode) && (pos = lseek(fd, 0, SEEK_CUR)) >= 0
+                && (st.st_size < pos || n > uint64(st.st_size - pos) / sizeof(limb)))
+                return false;
+            basic_bigint v;
+            for (uint64 done = 0; done < n;) {
+                uint64 chunk = std::min<uint64>(n - done, std::max<uint64>(done, 1 << 16));
+                v.a.resize(done + chunk);
+                if (!read_all(fd, (char *) (v.a.data() + done), chunk * sizeof(limb)))
+                    return false;
+                done += chunk;
+            }
+            swap_limbs(v.a.data(), n);
+            if (L::decimal)
+                for (uint64 i = 0; i < n; i++)
+                    if (v.a[i] >= L::base())
+                        return false;
+            v.sign = s;
+            v.trim();
+            *this = std::move(v);
+            return true;
+        }
+#endif
+
+        static limbs multiply(const limbs &x, const limbs &y) {
+            limbs res;
+            if (x.empty() || y.empty())
+                return res;
+            res.resize(x.size() + y.size());
+            std::vector<limb> ws(K::mul_scratch(x.size(), y.size()));
+            K::mul(res.data(), x.data(), x.size(), y.data(), y.size(), ws.data(), bigint_threads());
+            return res;
+        }
+
+        basic_bigint operator*(const basic_bigint &v) const {
+            basic_bigint res;
+            res.sign = sign * v.sign;
+            res.a = multiply(a, v.a);
+            res.trim();
+            return res;
+        }
+    };
+
+    typedef basic_bigint<decimal_limbs> bigint;
+    typedef basic_bigint<binary_limbs> binary_bigint;
+    typedef basic_int_divisor<decimal_limbs> int_divisor;
+    typedef basic_int_divisor<binary_limbs> binary_int_divisor;
+
+    // eight ASCII digits at a time in a 64-bit word, the first character in the lowest byte
+    struct __swar_digits {
+        static uint64 load(const char *p) {
+            uint64 v;
+            std::memcpy(&v, p, 8);
+            if (__BYTE_ORDER__ != __ORDER_LITTLE_ENDIAN__)
+                v = __builtin_bswap64(v);
+            return v;
+        }
+
+        // how many bytes of v, from the lowest, are '0'..'9'
+        static int count(uint64 v) {
+            uint64 t = ((v & 0xF0F0F0F0F0F0F0F0ull) |
+                        (((v + 0x0606060606060606ull) & 0xF0F0F0F0F0F0F0F0ull) >> 4)) ^ 0x3333333333333333ull;
+            return t ? __builtin_ctzll(t) >> 3 : 8;
+        }
+
+        // the first 0 < k <= 8 digits of v as a number: shifted up, the dropped bytes read as leading zeros
+        static uint32 value(uint64 v, int k) {
+            uint64 x = (v - 0x3030303030303030ull) << (64 - 8 * k);
+            x = x * 10 + (x >> 8);
+            return uint32(((x & 0x000000FF000000FFull) * 0x000F424000000064ull +
+                           ((x >> 16) & 0x000000FF000000FFull) * 0x0000271000000001ull) >> 32);
+        }
+
+        static uint32 power(int k) {
+            static const uint32 pow10[9] = {1, 10, 100, 1000, 10000, 100000, 1000000, 10000000, 100000000};
+            return pow10[k];
+        }
+
+        // value * 10^k + the k digits at s, wrapping like U; reads eight bytes at a time past the run,
+        // so s must be followed by readable bytes, as the padded input buffer is
+        template<typename U>
+        static const char *run(const char *s, U &value) {
+            for (;;) {
+                uint64 v = load(s);
+                int k = count(v);
+                if (k == 0)
+                    return s;
+                value = value * U(power(k)) + U(__swar_digits::value(v, k));
+                s += k;
+                if (k < 8)
+                    return s;
+            }
+        }
+    };
+
+    template<typename F>
+    struct __float_format;
+
+    template<>
+    struct __float_format<double> {
+        typedef uint64 bits;
+        static const int mantissa_bits = 52, min_exponent = -1023, infinite_power = 0x7FF;
+        static const int min_even = -4, max_even = 23, smallest_pow10 = -342, largest_pow10 = 308, exact_pow10 = 22;
+    };
+
+    template<>
+    struct __float_format<float> {
+        typedef uint32 bits;
+        static const int mantissa_bits = 23, min_exponent = -127, infinite_power = 0xFF;
+        static const int min_even = -17, max_even = 10, smallest_pow10 = -64, largest_pow10 = 38, exact_pow10 = 10;
+    };
+
+    // correctly rounded decimal to binary floating point (round to nearest, ties to even). Up to 19
+    // significant digits are gathered into one word w, and w * 10^q is rounded either exactly in hardware
+    // (Clinger: both fit the mantissa) or from a 128-bit product with a truncated 5^q (Eisel and Lemire).
+    // When more digits were given and w and w + 1 round apart, or the product cannot decide, the value is
+    // rounded from an exact binary_bigint quotient instead
+    struct __decimal_to_float {
+        static const int smallest_pow5 = -342, largest_pow5 = 308;
+
+        // 64 bits of v starting at bit pos
+        static uint64 bits_at(const binary_bigint &v, int64 pos) {
+            int64 i = pos >> 6, s = pos & 63, n = v.a.size();
+            uint64 lo = i >= 0 && i < n ? v.a[i] : 0, hi = i + 1 >= 0 && i + 1 < n ? v.a[i + 1] : 0;
+            if (i < 0)
+                return s ? hi << (64 - s) : 0;
+            return s ? lo >> s | hi << (64 - s) : lo;
+        }
+
+        static int64 bit_length(const binary_bigint &v) {
+            return v.a.empty() ? 0 : 64 * (int64) v.a.size() - __builtin_clzll(v.a.back());
+        }
+
+        // 5^q for q in [smallest_pow5, largest_pow5], normalized to 128 bits: truncated for q >= 0, for
+        // q < 0 one more than the truncated 2^b / 5^-q. Two words per power, high first
+        static const uint64 *powers_of_five() {
+            static const std::vector<uint64> table = [] {
+                std::vector<uint64> t;
+                binary_bigint five(5);
+                for (int q = smallest_pow5; q <= largest_pow5; q++) {
+                    binary_bigint c = five.pow(q < 0 ? -q : q);
+                    if (q < 0) {
+                        int64 b = q >= -27 ? bit_length(c) + 127 : 2 * bit_length(c) + 128;
+                        binary_bigint power_of_two;
+                        power_of_two.a.assign(b / 64 + 1, 0);
+                        power_of_two.a.back() = uint64(1) << (b & 63);
+                        c = divmod(power_of_two, c).first + binary_bigint(1);
+                    }
+                    int64 top = bit_length(c) - 128;
+                    t.push_back(bits_at(c, top + 64));
+                    t.push_back(bits_at(c, top));
+                }
+                return t;
+            }();
+            return table.data();
+        }
+
+        template<typename F>
+        static F assemble(bool negative, uint64 mantissa, int power) {
+            typedef __float_format<F> T;
+            typename T::bits b = typename T::bits(mantissa | uint64(power) << T::mantissa_bits);
+            b |= typename T::bits(negative) << (sizeof(F) * 8 - 1);
+            F res;
+            std::memcpy(&res, &b, sizeof(F));
+            return res;
+        }
+
+        // the biased exponent and mantissa of w * 10^q for w != 0, or false when the product lies too
+        // close to a rounding boundary to decide
+        template<typename F>
+        static bool eisel_lemire(uint64 w, int64 q, uint64 &mantissa, int &power) {
+            typedef __float_format<F> T;
+            if (q < T::smallest_pow10) {
+                mantissa = 0, power = 0;
+                return true;
+            }
+            if (q > T::largest_pow10) {
+                mantissa = 0, power = T::infinite_power;
+                return true;
+            }
+            typedef unsigned __int128 uint128;
+            const uint64 *p = powers_of_five() + 2 * (q - smallest_pow5);
+            int lz = __builtin_clzll(w);
+            w <<= lz;
+            uint128 first = uint128(w) * p[0];
+            uint64 high = uint64(first >> 64), low = uint64(first);
+            const uint64 mask = ~uint64(0) >> (T::mantissa_bits + 3);
+            if ((high & mask) == mask) {
+                uint64 second = uint64(uint128(w) * p[1] >> 64);
+                low += second;
+                high += low < second;
+                if (low == ~uint64(0) && (q < -27 || q > 55))
+                    return false;
+            }
+            int upper = int(high >> 63), shift = upper + 64 - T::mantissa_bits - 3;
+            mantissa = high >> shift;
+            // floor(log2(10^q)) + 63, exact over the table range
+            power = int((((152170 + 65536) * q) >> 16) + 63) + upper - lz - T::min_exponent;
+            if (power <= 0) {
+                if (1 - power >= 64) {
+                    mantissa = 0, power = 0;
+                    return true;
+                }
+                mantissa >>= 1 - power;
+                mantissa += mantissa & 1;
+                mantissa >>= 1;
+                power = mantissa < uint64(1) << T::mantissa_bits ? 0 : 1;
+                mantissa &= ~(uint64(1) << T::mantissa_bits);
+                return true;
+            }
+            // an exact halfway product that truncation made look above the midpoint rounds to even
+            if (low <= 1 && q >= T::min_even && q <= T::max_even && (mantissa & 3) == 1 &&
+                mantissa << shift == high)
+                mantissa &= ~uint64(1);
+            mantissa += mantissa & 1;
+            mantissa >>= 1;
+            if (mantissa >= uint64(2) << T::mantissa_bits) {
+                mantissa = uint64(1) << T::mantissa_bits;
+                power++;
+            }
+            mantissa &= ~(uint64(1) << T::mantissa_bits);
+            if (power >= T::infinite_power)
+                mantissa = 0, power = T::infinite_power;
+            return true;
+        }
+
+        // digits * 10^q rounded from the exact value; digits has no leading zeros
+        template<typename F>
+        static F slow(bool negative, const std::string &digits, int64 q) {
+            typedef __float_format<F> T;
+            int64 size = digits.size();
+            if (size + q > T::largest_pow10 + 1)
+                return assemble<F>(negative, 0, T::infinite_power);
+            if (size + q < T::smallest_pow10)
+                return assemble<F>(negative, 0, 0);
+            binary_bigint m(digits), ten(10);
+            int64 e2 = 0;
+            bool sticky = false;
+            if (q >= 0) {
+                m *= ten.pow(q);
+            } else {
+                binary_bigint d = ten.pow(-q);
+                int k = (int) d.a.size() - (int) m.a.size() + 2;
+                std::pair<binary_bigint, binary_bigint> qr = divmod(m.shift_limbs(k), d);
+                m = qr.first;
+                sticky = !qr.second.a.empty();
+                e2 = -64 * (int64) k;
+            }
+            // m * 2^e2 plus a sticky fraction, rounded to the mantissa bits at the lowest allowed exponent
+            const int precision = T::mantissa_bits + 1, min_lsb = T::min_exponent + 2 - precision;
+            int64 lsb = std::max<int64>(e2 + bit_length(m) - precision, min_lsb), s = lsb - e2;
+            uint64 mantissa;
+            if (s <= 0) {
+                mantissa = m.a.empty() ? 0 : m.a[0] << -s;
+            } else {
+                mantissa = bits_at(m, s) & ((uint64(2) << T::mantissa_bits) - 1);
+                bool half = bits_at(m, s - 1) & 1;
+                for (int64 i = 0; i < (s - 1) / 64 && !sticky; i++)
+                    sticky = m.a[i] != 0;
+                sticky |= ((s - 1) & 63) && bits_at(m, (s - 1) / 64 * 64) << (64 - ((s - 1) & 63));
+                if (half && (sticky || (mantissa & 1)))
+                    mantissa++;
+                if (mantissa >> precision) {
+                    mantissa >>= 1;
+                    lsb++;
+                }
+            }
+            if (!(mantissa >> T::mantissa_bits))
+                return assemble<F>(negative, mantissa, 0);
+            int64 power = lsb + T::mantissa_bits - T::min_exponent;
+            if (power >= T::infinite_power)
+                return assemble<F>(negative, 0, T::infinite_power);
+            return assemble<F>(negative, mantissa & ((uint64(1) << T::mantissa_bits) - 1), int(power));
+        }
+
+        // the digits at s appended to w, wrapping, and the end of the run
+        static const char *digit_run(const char *s, uint64 &w, bool padded) {
+            if (padded)
+                return __swar_digits::run(s, w);
+            for (unsigned d; (d = unsigned(*s - '0')) < 10; s++)
+                w = w * 10 + d;
+            return s;
+        }
+
+        // parses [+-]digits[.digits][(e|E)[+-]digits] at s and returns the end of the number; no digits
+        // at all give zero. padded input has eight readable bytes past the number and is scanned by words
+        template<typename F>
+        static const char *parse(const char *s, F &value, bool padded = false) {
+            typedef __float_format<F> T;
+            bool negative = *s == '-';
+            if (*s == '-' || *s == '+')
+                s++;
+            const char *first = s;
+            while (*s == '0')
+                s++;
+            // sig is the first significant digit; w takes every digit and is only right up to 19 of them
+            const char *sig = s;
+            uint64 w = 0;
+            s = digit_run(s, w, padded);
+            int64 digits = s - sig, frac_digits = 0;
+            bool seen = s > first;
+            if (*s == '.') {
+                const char *frac = ++s;
+                if (!digits) {
+                    while (*s == '0')
+                        s++;
+                    sig = s;
+                }
+                const char *run = s;
+                s = digit_run(s, w, padded);
+                digits += s - run;
+                frac_digits = s - frac;
+                seen |= frac_digits > 0;
+            }
+            if (!seen) {
+                value = 0;
+                return s;
+            }
+            const char *last = s;
+            int64 exponent = 0;
+            if (*s == 'e' || *s == 'E') {
+                const char *e = s + 1;
+                bool negative_exponent = *e == '-';
+                if (*e == '-' || *e == '+')
+                    e++;
+                if (unsigned(*e - '0') < 10) {
+                    for (unsigned d; (d = unsigned(*e - '0')) < 10; e++)
+                        if (exponent < (int64(1) << 40))
+                            exponent = exponent * 10 + d;
+                    s = e;
+                    if (negative_exponent)
+                        exponent = -exponent;
+                }
+            }
+            if (!digits) {
+                value = assemble<F>(negative, 0, 0);
+                return s;
+            }
+            int64 q = exponent - frac_digits;
+            bool truncated = false;
+            if (digits > 19) {
+                const char *p = sig;
+                w = 0;
+                for (int n = 0; n < 19; p++)
+                    if (*p != '.')
+                        w = w * 10 + unsigned(*p - '0'), n++;
+                for (; p < last && !truncated; p++)
+                    truncated = *p != '0' && *p != '.';
+                q += digits - 19;
+            }
+            if (!truncated && q >= -T::exact_pow10 && q <= T::exact_pow10 &&
+                w <= uint64(1) << (T::mantissa_bits + 1)) {
+                static const F pow10[] = {1e0, 1e1, 1e2, 1e3, 1e4, 1e5, 1e6, 1e7, 1e8, 1e9, 1e10, 1e11, 1e12,
+                                          1e13, 1e14, 1e15, 1e16, 1e17, 1e18, 1e19, 1e20, 1e21, 1e22};
+                value = q < 0 ? F(w) / pow10[-q] : F(w) * pow10[q];
+                if (negative)
+                    value = -value;
+                return s;
+            }
+            uint64 mantissa, mantissa_up;
+            int power, power_up;
+            if (eisel_lemire<F>(w, q, mantissa, power) &&
+                (!truncated || (eisel_lemire<F>(w + 1, q, mantissa_up, power_up) &&
+                                mantissa == mantissa_up && power == power_up))) {
+                value = assemble<F>(negative, mantissa, power);
+                return s;
+            }
+            std::string all;
+            for (const char *p = sig; p < last; p++)
+                if (*p != '.')
+                    all += *p;
+            value = slow<F>(negative, all, exponent - frac_digits);
+            return s;
+        }
+    };
+
+    namespace math {
+        float64 double_from_string(char* str) {
+            float64 number;
+            __decimal_to_float::parse(str, number);
+            return number;
+        }
+
+        float32 float_from_string(char* str) {
+            float32 number;
+            __decimal_to_float::parse(str, number);
+            return number;
+        }
+    }
+
+    // fixed-width two's complement integer of Bits bits (a multiple of 64) in uint64 limbs on the stack.
+    // Arithmetic wraps modulo 2^Bits like the built-in unsigned types, division truncates toward zero and
+    // >> is arithmetic when Signed. All limb loops have constant trip counts, so small widths compile to
+    // straight-line code; from C++14 on everything but the string and bigint conversions is constexpr
+    template<int Bits, bool Signed = false>
+    struct wide_int {
+        static_assert(Bits > 0 && Bits % 64 == 0, "wide_int width must be a positive multiple of 64");
+        static const int n = Bits / 64;
+        typedef unsigned __int128 dlimb;
+
+        uint64 a[n];
+
+        constexpr wide_int() :
+                a() {
+        }
+
+        template<typename T, typename = typename std::enable_if<std::is_integral<T>::value>::type>
+        CONSTEXPR14 wide_int(T v) :
+                a() {
+            a[0] = uint64(v);
+            UNROLL
+            for (int i = 1; i < n; i++)
+                a[i] = std::is_signed<T>::value && v < T(0) ? ~uint64(0) : 0;
+        }
+
+        // truncates or extends, by sign when the source is signed
+        template<int B, bool S>
+        explicit CONSTEXPR14 wide_int(const wide_int<B, S> &v) :
+                a() {
+            UNROLL
+            for (int i = 0; i < n; i++)
+                a[i] = i < v.n ? v.a[i] : v.negative() ? ~uint64(0) : 0;
+        }
+
+        // |v| mod 2^Bits with the sign of v applied
+        template<typename L>
+        explicit wide_int(const basic_bigint<L> &v) :
+                a() {
+            if (L::decimal) {
+                for (int i = (int) v.a.size() - 1; i >= 0; i--)
+                    mul_add_small(L::base(), v.a[i]);
+            } else {
+                for (int i = 0; i < n && i < (int) v.a.size(); i++)
+                    a[i] = uint64(v.a[i]);
+            }
+            if (v.sign < 0)
+                *this = -*this;
+        }
+
+        explicit wide_int(const std::string &s) :
+                a() {
+            size_t i = 0;
+            bool neg = false;
+            for (; i < s.size() && (s[i] == '-' || s[i] == '+'); i++)
+                neg ^= s[i] == '-';
+            for (; i < s.size(); i++)
+                mul_add_small(10, s[i] - '0');
+            if (neg)
+                *this = -*this;
+        }
+
+        constexpr bool negative() const {
+            return Signed && (a[n - 1] >> 63);
+        }
+
+        template<typename T, typename = typename std::enable_if<std::is_integral<T>::value>::type>
+        explicit constexpr operator T() const {
+            return T(a[0]);
+        }
+
+        CONSTEXPR14 explicit operator bool() const {
+            UNROLL
+            for (int i = 0; i < n; i++)
+                if (a[i])
+                    return true;
+            return false;
+        }
+
+        template<typename L>
+        basic_bigint<L> to_bigint() const {
+            basic_bigint<L> res;
+            wide_int m = negative() ? -*this : *this;
+            if (L::decimal) {
+                while (m)
+                    res.a.push_back(typename L::limb(m.divrem_small(L::base())));
+            } else {
+                for (int i = 0; i < n; i++)
+                    res.a.push_back(typename L::limb(m.a[i]));
+            }
+            res.sign = negative() ? -1 : 1;
+            res.trim();
+            return res;
+        }
+
+        std::string to_string() const {
+            if (!*this)
+                return "0";
+            wide_int m = negative() ? -*this : *this;
+            std::string res;
+            while (m) {
+                uint64 chunk = m.divrem_small(10000000000000000000ull);
+                for (int i = 0; i < 19 && (m || chunk); i++, chunk /= 10)
+                    res.push_back(char('0' + chunk % 10));
+            }
+            if (negative())
+                res.push_back('-');
+            return std::string(res.rbegin(), res.rend());
+        }
+
+        friend std::ostream &operator<<(std::ostream &stream, const wide_int &v) {
+            return stream << v.to_string();
+        }
+
+        // *this = *this * m + c for m, c < 2^64
+        CONSTEXPR14 void mul_add_small(uint64 m, uint64 c) {
+            UNROLL
+            for (int i = 0; i < n; i++) {
+                dlimb p = (dlimb) a[i] * m + c;
+                a[i] = uint64(p);
+                c = uint64(p >> 64);
+            }
+        }
+
+        // unsigned *this /= d, returns the remainder
+        CONSTEXPR14 uint64 divrem_small(uint64 d) {
+            dlimb r = 0;
+            UNROLL
+            for (int i = n - 1; i >= 0; i--) {
+                dlimb cur = r << 64 | a[i];
+                a[i] = uint64(cur / d);
+                r = cur % d;
+            }
+            return uint64(r);
+        }
+
+        // unsigned quotient and remainder; Knuth's algorithm D on the significant limbs
+        static CONSTEXPR14 void udivmod(const wide_int &u, const wide_int &v, wide_int &q, wide_int &r) {
+            int m = n, k = n;
+            while (m > 0 && u.a[m - 1] == 0)
+                m--;
+            while (k > 0 && v.a[k - 1] == 0)
+                k--;
+            q = wide_int();
+            r = wide_int();
+            if (k <= 1) {
+                q = u;
+                r.a[0] = q.divrem_small(v.a[0]);
+                return;
+            }
+            if (m < k) {
+                r = u;
+                return;
+            }
+            int s = __builtin_clzll(v.a[k - 1]);
+            uint64 un[n + 1] = {}, vn[n] = {};
+            for (int i = k - 1; i > 0; i--)
+                vn[i] = v.a[i] << s | (s ? v.a[i - 1] >> (64 - s) : 0);
+            vn[0] = v.a[0] << s;
+            un[m] = s ? u.a[m - 1] >> (64 - s) : 0;
+            for (int i = m - 1; i > 0; i--)
+                un[i] = u.a[i] << s | (s ? u.a[i - 1] >> (64 - s) : 0);
+            un[0] = u.a[0] << s;
+            for (int j = m - k; j >= 0; j--) {
+                dlimb top = (dlimb) un[j + k] << 64 | un[j + k - 1];
+                dlimb qh = top / vn[k - 1], rh = top % vn[k - 1];
+                while ((qh >> 64) || qh * vn[k - 2] > (rh << 64 | un[j + k - 2])) {
+                    qh--;
+                    rh += vn[k - 1];
+                    if (rh >> 64)
+                        break;
+                }
+                uint64 carry = 0, borrow = 0;
+                for (int i = 0; i < k; i++) {
+                    dlimb p = (dlimb) uint64(qh) * vn[i] + carry;
+                    carry = uint64(p >> 64);
+                    dlimb d = (dlimb) un[i + j] - uint64(p) - borrow;
+                    un[i + j] = uint64(d);
+                    borrow = uint64(d >> 64) & 1;
+                }
+                dlimb d = (dlimb) un[j + k] - carry - borrow;
+                un[j + k] = uint64(d);
+                q.a[j] = uint64(qh);
+                if (d >> 64) {
+                    // qh was one too large: add the divisor back
+                    q.a[j]--;
+                    uint64 c = 0;
+                    for (int i = 0; i < k; i++) {
+                        dlimb t = (dlimb) un[i + j] + vn[i] + c;
+                        un[i + j] = uint64(t);
+                        c = uint64(t >> 64);
+                    }
+                    un[j + k] += c;
+                }
+            }
+            for (int i = 0; i < k; i++)
+                r.a[i] = un[i] >> s | (s ? un[i + 1] << (64 - s) : 0);
+        }
+
+        // quotient truncated toward zero, remainder with the sign of u
+        friend CONSTEXPR14 void divmod(const wide_int &u, const wide_int &v, wide_int &q, wide_int &r) {
+            bool nu = u.negative(), nv = v.negative();
+            udivmod(nu ? -u : u, nv ? -v : v, q, r);
+            if (nu != nv)
+                q = -q;
+            if (nu)
+                r = -r;
+        }
+
+        CONSTEXPR14 wide_int &operator+=(const wide_int &v) {
+            uint64 c = 0;
+            UNROLL
+            for (int i = 0; i < n; i++) {
+                dlimb s = (dlimb) a[i] + v.a[i] + c;
+                a[i] = uint64(s);
+                c = uint64(s >> 64);
+            }
+            return *this;
+        }
+
+        CONSTEXPR14 wide_int &operator-=(const wide_int &v) {
+            uint64 b = 0;
+            UNROLL
+            for (int i = 0; i < n; i++) {
+                dlimb d = (dlimb) a[i] - v.a[i] - b;
+                a[i] = uint64(d);
+                b = uint64(d >> 64) & 1;
+            }
+            return *this;
+        }
+
+        // the low Bits bits of the product, the same for signed and unsigned operands
+        CONSTEXPR14 wide_int &operator*=(const wide_int &v) {
+            wide_int r;
+            UNROLL
+            for (int i = 0; i < n; i++) {
+                uint64 c = 0;
+                UNROLL
+                for (int j = 0; i + j < n; j++) {
+                    dlimb p = (dlimb) a[i] * v.a[j] + r.a[i + j] + c;
+                    r.a[i + j] = uint64(p);
+                    c = uint64(p >> 64);
+                }
+            }
+            return *this = r;
+        }
+
+        CONSTEXPR14 wide_int &operator/=(const wide_int &v) {
+            wide_int q, r;
+            divmod(*this, v, q, r);
+            return *this = q;
+        }
+
+        CONSTEXPR14 wide_int &operator%=(const wide_int &v) {
+            wide_int q, r;
+            divmod(*this, v, q, r);
+            return *this = r;
+        }
+
+        // shifts by 0 <= s < Bits
+        CONSTEXPR14 wide_int &operator<<=(int s) {
+            int w = s / 64, b = s % 64;
+            UNROLL
+            for (int i = n - 1; i >= 0; i--) {
+                uint64 hi = i - w >= 0 ? a[i - w] : 0, lo = i - w - 1 >= 0 ? a[i - w - 1] : 0;
+                a[i] = hi << b | (b ? lo >> (64 - b) : 0);
+            }
+            return *this;
+        }
+
+        CONSTEXPR14 wide_int &operator>>=(int s) {
+            int w = s / 64, b = s % 64;
+            uint64 fill = negative() ? ~uint64(0) : 0;
+            UNROLL
+            for (int i = 0; i < n; i++) {
+                uint64 lo = i + w < n ? a[i + w] : fill, hi = i + w + 1 < n ? a[i + w + 1] : fill;
+                a[i] = lo >> b | (b ? hi << (64 - b) : 0);
+            }
+            return *this;
+        }
+
+        CONSTEXPR14 wide_int &operator&=(const wide_int &v) {
+            UNROLL
+            for (int i = 0; i < n; i++)
+                a[i] &= v.a[i];
+            return *this;
+        }
+
+        CONSTEXPR14 wide_int &operator|=(const wide_int &v) {
+            UNROLL
+            for (int i = 0; i < n; i++)
+                a[i] |= v.a[i];
+            return *this;
+        }
+
+        CONSTEXPR14 wide_int &operator^=(const wide_int &v) {
+            UNROLL
+            for (int i = 0; i < n; i++)
+                a[i] ^= v.a[i];
+            return *this;
+        }
+
+        CONSTEXPR14 wide_int operator~() const {
+            wide_int r;
+            UNROLL
+            for (int i = 0; i < n; i++)
+                r.a[i] = ~a[i];
+            return r;
+        }
+
+        CONSTEXPR14 wide_int operator-() const {
+            wide_int r = ~*this;
+            return r += wide_int(1);
+        }
+
+        CONSTEXPR14 wide_int &operator++() {
+            return *this += wide_int(1);
+        }
+
+        CONSTEXPR14 wide_int &operator--() {
+            return *this -= wide_int(1);
+        }
+
+        friend CONSTEXPR14 wide_int operator+(wide_int x, const wide_int &y) {
+            return x += y;
+        }
+
+        friend CONSTEXPR14 wide_int operator-(wide_int x, const wide_int &y) {
+            return x -= y;
+        }
+
+        friend CONSTEXPR14 wide_int operator*(wide_int x, const wide_int &y) {
+            return x *= y;
+        }
+
+        friend CONSTEXPR14 wide_int operator/(wide_int x, const wide_int &y) {
+            return x /= y;
+        }
+
+        friend CONSTEXPR14 wide_int operator%(wide_int x, const wide_int &y) {
+            return x %= y;
+        }
+
+        friend CONSTEXPR14 wide_int operator<<(wide_int x, int s) {
+            return x <<= s;
+        }
+
+        friend CONSTEXPR14 wide_int operator>>(wide_int x, int s) {
+            return x >>= s;
+        }
+
+        friend CONSTEXPR14 wide_int operator&(wide_int x, const wide_int &y) {
+            return x &= y;
+        }
+
+        friend CONSTEXPR14 wide_int operator|(wide_int x, const wide_int &y) {
+            return x |= y;
+        }
+
+        friend CONSTEXPR14 wide_int operator^(wide_int x, const wide_int &y) {
+            return x ^= y;
+        }
+
+        static CONSTEXPR14 int cmp(const wide_int &x, const wide_int &y) {
+            if (x.negative() != y.negative())
+                return x.negative() ? -1 : 1;
+            UNROLL
+            for (int i = n - 1; i >= 0; i--)
+                if (x.a[i] != y.a[i])
+                    return x.a[i] < y.a[i] ? -1 : 1;
+            return 0;
+        }
+
+        friend CONSTEXPR14 bool operator==(const wide_int &x, const wide_int &y) {
+            return cmp(x, y) == 0;
+        }
+
+        friend CONSTEXPR14 bool operator!=(const wide_int &x, const wide_int &y) {
+            return cmp(x, y) != 0;
+        }
+
+        friend CONSTEXPR14 bool operator<(const wide_int &x, const wide_int &y) {
+            return cmp(x, y) < 0;
+        }
+
+        friend CONSTEXPR14 bool operator>(const wide_int &x, const wide_int &y) {
+            return cmp(x, y) > 0;
+        }
+
+        friend CONSTEXPR14 bool operator<=(const wide_int &x, const wide_int &y) {
+            return cmp(x, y) <= 0;
+        }
+
+        friend CONSTEXPR14 bool operator>=(const wide_int &x, const wide_int &y) {
+            return cmp(x, y) >= 0;
+        }
+    };
+
+    template<int Bits>
+    using wide_uint = wide_int<Bits, false>;
+    template<int Bits>
+    using wide_sint = wide_int<Bits, true>;
+
+    // arbitrary precision floating point m * base^e for the limb base of L, with at most prec limbs of
+    // mantissa; results take the larger precision of the operands. Rounding is to nearest with ties to
+    // even at limb granularity: sums, quotients, square roots and decimal conversions are correctly
+    // rounded when the divisor fits in prec + 2 limbs. Products of two operands longer than about
+    // prec / 2 limbs come from a short product of their top limbs and are faithful, others are exact
+    template<typename L>
+    struct basic_bigfloat {
+        typedef basic_bigint<L> value_type;
+        typedef typename L::limb limb;
+        typedef __mpn<L> K;
+
+        value_type m;
+        int64 e;
+        int prec;
+
+        basic_bigfloat() :
+                e(0), prec(1) {
+        }
+
+        // prec 0 keeps every limb of v
+        basic_bigfloat(const value_type &v, int prec = 0) {
+            *this = round(v, 0, prec > 0 ? prec : std::max(1, (int) v.a.size()), false);
+        }
+
+        basic_bigfloat(long long v, int prec = 0) :
+                basic_bigfloat(value_type(v), prec) {
+        }
+
+        basic_bigfloat(const std::string &s, int prec) {
+            read(s, prec);
+        }
+
+        // limbs that hold the given number of significant decimal digits, and back
+        static int limbs_for_digits(int digits) {
+            return L::decimal ? (digits + bigint_base_digits - 1) / bigint_base_digits : (digits + 18) / 19;
+        }
+
+        static int digits_for_limbs(int limbs) {
+            return L::decimal ? limbs * bigint_base_digits : limbs * 19;
+        }
+
+        // the position just above the top limb
+        int64 top() const {
+            return e + (int64) m.a.size();
+        }
+
+        bool is_zero() const {
+            return m.a.empty();
+        }
+
+        // (v + sticky * d) * base^e with 0 < d < 1 rounded to p limbs; the sticky part only breaks ties
+        // and rounds away from exact truncations, so exact results need no sticky
+        static basic_bigfloat round(value_type v, int64 e, int p, bool sticky) {
+            basic_bigfloat res;
+            res.prec = p;
+            int s = (int) v.a.size() - p;
+            if (sticky && s <= 0) {
+                v = v.shift_limbs(1 - s);
+                e -= 1 - s;
+                s = 1;
+            }
+            if (s > 0) {
+                limb r = v.a[s - 1];
+                bool rest = sticky;
+                for (int i = 0; i < s - 1 && !rest; i++)
+                    rest = v.a[i] != 0;
+                v = v.shift_limbs(-s);
+                e += s;
+                typename L::dlimb half = L::base() / 2;
+                if (r > half || (r == half && (rest || (!v.a.empty() && (v.a[0] & 1)))))
+                    v += value_type(v.sign);
+                if ((int) v.a.size() > p) {
+                    v = v.shift_limbs(-1);
+                    e++;
+                }
+            }
+            int z = 0;
+            while (z < (int) v.a.size() && !v.a[z])
+                z++;
+            res.m = v.shift_limbs(-z);
+            res.e = res.m.a.empty() ? 0 : e + z;
+            return res;
+        }
+
+        // (a base^ea) / (b base^eb) rounded to p limbs, exactly: the quotient gets p + 1 or p + 2 limbs
+        // and the remainder decides the rounding
+        static basic_bigfloat quotient(const value_type &a, int64 ea, const value_type &b, int64 eb, int p) {
+            if (a.a.empty())
+                return round(value_type(), 0, p, false);
+            int s = p + 2 + (int) b.a.size() - (int) a.a.size();
+            bool sticky = false;
+            for (int i = 0; i < -s && !sticky; i++)
+                sticky = a.a[i] != 0;
+            std::pair<value_type, value_type> qr = divmod(a.abs().shift_limbs(s), b.abs());
+            sticky |= !qr.second.a.empty();
+            if (!qr.first.a.empty())
+                qr.first.sign = a.sign * b.sign;
+            return round(qr.first, ea - eb - s, p, sticky);
+        }
+
+        static basic_bigfloat add_signed(const basic_bigfloat &x, const basic_bigfloat &y, int sign_y) {
+            int p = std::max(x.prec, y.prec);
+            value_type xm = x.m, ym = y.m;
+            int64 xe = x.e, ye = y.e;
+            if (sign_y < 0)
+                ym = -ym;
+            if (xm.a.empty())
+                return round(ym, ye, p, false);
+            if (y.top() > x.top()) {
+                std::swap(xm, ym);
+                std::swap(xe, ye);
+            }
+            if (ym.a.empty())
+                return round(xm, xe, p, false);
+            int64 tx = xe + (int64) xm.a.size(), ty = ye + (int64) ym.a.size();
+            if (ty <= tx - 2) {
+                // the sum keeps its top limb at tx - 1 or higher, so the part of y below base^b only
+                // decides on which side of a multiple of base^b it lies: one unit at b - 1 stands in
+                int64 b = std::min(xe, tx - p - 2);
+                if (ye < b) {
+                    int drop = (int) std::min<int64>(b - ye, (int64) ym.a.size()), sign = ym.sign;
+                    bool sticky = false;
+                    for (int i = 0; i < drop && !sticky; i++)
+                        sticky = ym.a[i] != 0;
+                    ym = ym.shift_limbs(-drop);
+                    value_type sum = xm.shift_limbs((int) (xe - b + 1)) + ym.shift_limbs(1);
+                    if (sticky)
+                        sum += value_type(sign);
+                    return round(sum, b - 1, p, false);
+                }
+            }
+            int64 e0 = std::min(xe, ye);
+            return round(xm.shift_limbs((int) (xe - e0)) + ym.shift_limbs((int) (ye - e0)), e0, p, false);
+        }
+
+        basic_bigfloat operator+(const basic_bigfloat &v) const {
+            return add_signed(*this, v, 1);
+        }
+
+        basic_bigfloat operator-(const basic_bigfloat &v) const {
+            return add_signed(*this, v, -1);
+        }
+
+        basic_bigfloat operator-() const {
+            basic_bigfloat res = *this;
+            res.m = -res.m;
+            return res;
+        }
+
+        basic_bigfloat operator*(const basic_bigfloat &v) const {
+            int p = std::max(prec, v.prec), n = p + 2, xn = m.a.size(), yn = v.m.a.size();
+            if (2 * std::min(xn, yn) <= n)
+                return round(m * v.m, e + v.e, p, false);
+            // both operands padded or cut to their top n limbs, the product truncated to its high half
+            std::vector<limb> xs(n), ys(n), r(2 * n), ws(K::mulhigh_scratch(n));
+            std::copy(m.a.end() - std::min(xn, n), m.a.end(), xs.end() - std::min(xn, n));
+            std::copy(v.m.a.end() - std::min(yn, n), v.m.a.end(), ys.end() - std::min(yn, n));
+            K::mulhigh_n(r.data(), xs.data(), this == &v ? xs.data() : ys.data(), n, ws.data());
+            value_type h;
+            h.a.assign(r.data() + n, r.data() + 2 * n);
+            h.trim();
+            h.sign = m.sign * v.m.sign;
+            return round(h, e + xn + v.e + yn - n, p, true);
+        }
+
+        basic_bigfloat operator/(const basic_bigfloat &v) const {
+            int p = std::max(prec, v.prec), drop = std::max(0, (int) v.m.a.size() - p - 2);
+            return quotient(m, e, v.m.shift_limbs(-drop), v.e + drop, p);
+        }
+
+        void operator+=(const basic_bigfloat &v) {
+            *this = *this + v;
+        }
+
+        void operator-=(const basic_bigfloat &v) {
+            *this = *this - v;
+        }
+
+        void operator*=(const basic_bigfloat &v) {
+            *this = *this * v;
+        }
+
+        void operator/=(const basic_bigfloat &v) {
+            *this = *this / v;
+        }
+
+        // correctly rounded, 0 for negative values
+        basic_bigfloat sqrt() const {
+            if (m.a.empty() || m.sign < 0)
+                return round(value_type(), 0, prec, false);
+            // m base^t with e - t even and at least 2 prec + 2 limbs has a root of prec + 1 limbs or more
+            int64 t = 2 * (int64) prec + 2 - (int64) m.a.size();
+            if ((e - t) & 1)
+                t++;
+            bool sticky = false;
+            for (int i = 0; i < -t && !sticky; i++)
+                sticky = m.a[i] != 0;
+            value_type n = m.shift_limbs((int) t), r = n.isqrt();
+            sticky |= !(r.sqr() == n);
+            return round(r, (e - t) / 2, prec, sticky);
+        }
+
+        static int cmp(const basic_bigfloat &x, const basic_bigfloat &y) {
+            int sx = x.m.a.empty() ? 0 : x.m.sign, sy = y.m.a.empty() ? 0 : y.m.sign;
+            if (sx != sy || !sx)
+                return sx < sy ? -1 : sx > sy;
+            if (x.top() != y.top())
+                return x.top() < y.top() ? -sx : sx;
+            for (int64 i = x.top() - 1; i >= std::min(x.e, y.e); i--) {
+                limb a = i >= x.e ? x.m.a[i - x.e] : 0, b = i >= y.e ? y.m.a[i - y.e] : 0;
+                if (a != b)
+                    return a < b ? -sx : sx;
+            }
+            return 0;
+        }
+
+        bool operator<(const basic_bigfloat &v) const {
+            return cmp(*this, v) < 0;
+        }
+
+        bool operator>(const basic_bigfloat &v) const {
+            return cmp(*this, v) > 0;
+        }
+
+        bool operator<=(const basic_bigfloat &v) const {
+            return cmp(*this, v) <= 0;
+        }
+
+        bool operator>=(const basic_bigfloat &v) const {
+            return cmp(*this, v) >= 0;
+        }
+
+        bool operator==(const basic_bigfloat &v) const {
+            return cmp(*this, v) == 0;
+        }
+
+        bool operator!=(const basic_bigfloat &v) const {
+            return cmp(*this, v) != 0;
+        }
+
+        static value_type pow10(int64 k) {
+            return value_type(10).pow(k);
+        }
+
+        // [+-]digits[.digits][(e|E)[+-]digits], correctly rounded to p limbs
+        void read(const std::string &s, int p) {
+            size_t i = 0;
+            int sign = 1;
+            for (; i < s.size() && (s[i] == '-' || s[i] == '+'); i++)
+                if (s[i] == '-')
+                    sign = -sign;
+            std::string digits;
+            int64 k = 0;
+            for (; i < s.size() && isdigit(s[i]); i++)
+                digits += s[i];
+            if (i < s.size() && s[i] == '.')
+                for (i++; i < s.size() && isdigit(s[i]); i++, k--)
+                    digits += s[i];
+            if (i < s.size() && (s[i] == 'e' || s[i] == 'E'))
+                k += atoll(s.c_str() + i + 1);
+            value_type d(digits.empty() ? std::string("0") : digits);
+            d.sign = d.a.empty() ? 1 : sign;
+            if (L::decimal) {
+                // 10^k = 10^r base^q, nothing to divide
+                int64 q = k >= 0 ? k / bigint_base_digits : -((-k + bigint_base_digits - 1) / bigint_base_digits);
+                *this = round(d * pow10(k - q * bigint_base_digits), q, p, false);
+            } else if (k >= 0) {
+                *this = round(d * pow10(k), 0, p, false);
+            } else {
+                *this = quotient(d, 0, pow10(-k), 0, p);
+            }
+        }
+
+        // scientific notation with the given number of significant digits, correctly rounded
+        std::string to_string(int digits) const {
+            if (m.a.empty())
+                return "0";
+            // q = round(|v| 10^(digits - 1 - t)) for an estimate t of floor(log10 |v|), fixed up
+            // until q has exactly the requested digits
+            const long double b = (long double) L::base();
+            long double top_limbs = m.a.back() + (m.a.size() > 1 ? m.a[m.a.size() - 2] / b : 0);
+            int64 t = (int64) floorl(log10l(top_limbs) + (long double) (top() - 1) * log10l(b));
+            value_type lo = pow10(digits - 1), hi = lo * value_type(10), q;
+            for (;;) {
+                value_type num = m.abs().shift_limbs((int) std::max<int64>(e, 0)), den = value_type(1).shift_limbs((int) std::max<int64>(-e, 0));
+                int64 a = digits - 1 - t;
+                if (a > 0)
+                    num *= pow10(a);
+                else
+                    den *= pow10(-a);
+                std::pair<value_type, value_type> qr = divmod(num, den);
+                q = qr.first;
+                if (q < lo) {
+                    t--;
+                    continue;
+                }
+                if (!(q < hi)) {
+                    t++;
+                    continue;
+                }
+                value_type r2 = qr.second + qr.second;
+                int c = value_type::cmp_abs(r2.a, den.a);
+                if (c > 0 || (c == 0 && q.a[0] % 2))
+                    q += value_type(1);
+                if (q == hi) {
+                    q = lo;
+                    t++;
+                }
+                break;
+            }
+            std::ostringstream out;
+            out << q;
+            std::string ds = out.str(), res = m.sign < 0 ? "-" : "";
+            res += ds[0];
+            if (digits > 1)
+                res += "." + ds.substr(1);
+            if (t != 0)
+                res += "e" + std::to_string(t);
+            return res;
+        }
+
+        double to_double() const {
+            return strtod(to_string(17).c_str(), nullptr);
+        }
+
+        friend std::ostream &operator<<(std::ostream &stream, const basic_bigfloat &v) {
+            return stream << v.to_string(digits_for_limbs(v.prec));
+        }
+
+        // pi to p limbs from the Chudnovsky series, summed by binary splitting:
+        // pi = 426880 sqrt(10005) Q / T, about 14 digits a term
+        static basic_bigfloat pi(int p) {
+            long long terms = digits_for_limbs(p) / 14 + 2;
+            value_type P, Q, T;
+            value_type::binary_splitting(0, terms,
+                    [](long long k) {
+                        return k == 0 ? value_type(1) : value_type(-(6 * k - 5) * (2 * k - 1)) * value_type(6 * k - 1);
+                    },
+                    [](long long k) {
+                        return k == 0 ? value_type(1) : value_type(k) * value_type(k * k) * value_type(10939058860032000ll);
+                    },
+                    [](long long k) {
+                        return value_type(13591409 + 545140134 * k);
+                    }, P, Q, T);
+            basic_bigfloat r = basic_bigfloat(10005, p + 1).sqrt() * basic_bigfloat(Q * value_type(426880), p + 1)
+                               / basic_bigfloat(T, p + 1);
+            return round(r.m, r.e, p, false);
+        }
+    };
+
+    typedef basic_bigfloat<decimal_limbs> bigfloat;
+    typedef basic_bigfloat<binary_limbs> binary_bigfloat;
+
+    // exact fraction p / q over basic_bigint<L> with q > 0, reduced lazily: sums leave common factors in,
+    // and a value is brought to lowest terms when compared, printed or asked for num() / den(), or when
+    // it has grown past twice its size at the last reduction, so gcd work is amortized along a chain.
+    // Products of reduced operands cancel across first (Henrici): with gcd(a, d) and gcd(c, b) divided
+    // out, a/b * c/d is already in lowest terms and no gcd of the full product is needed
+    template<typename L>
+    struct basic_rational {
+        typedef basic_bigint<L> value_type;
+
+        // limbs an unreduced value may grow beyond twice its reduced size before it is reduced
+        static const int reduce_slack = 8;
+
+        mutable value_type p, q;
+        mutable bool reduced;
+        // size of p and q in limbs at the last reduction
+        mutable int base;
+
+        basic_rational() :
+                p(0), q(1), reduced(true), base(1) {
+        }
+
+        basic_rational(long long v) :
+                p(v), q(1), reduced(true), base(size()) {
+        }
+
+        basic_rational(const value_type &v) :
+                p(v), q(1), reduced(true), base(size()) {
+        }
+
+        basic_rational(const value_type &num, const value_type &den) :
+                p(num), q(den), reduced(false), base(0) {
+            if (q.sign < 0) {
+                p = -p;
+                q = -q;
+            }
+            normalize();
+        }
+
+        explicit basic_rational(const std::string &s) {
+            read(s);
+        }
+
+        int size() const {
+            return p.a.size() + q.a.size();
+        }
+
+        void normalize() const {
+            if (reduced)
+                return;
+            value_type g = gcd(p, q);
+            if (!(g == value_type(1))) {
+                p = p / g;
+                q = q / g;
+            }
+            if (p.a.empty())
+                q = value_type(1);
+            reduced = true;
+            base = size();
+        }
+
+        const value_type &num() const {
+            normalize();
+            return p;
+        }
+
+        const value_type &den() const {
+            normalize();
+            return q;
+        }
+
+        // an unreduced result starts from the larger base of its operands
+        static basic_rational lazy(const value_type &num, const value_type &den, int base) {
+            basic_rational res;
+            res.p = num;
+            res.q = den;
+            res.reduced = res.p.a.empty();
+            if (res.reduced)
+                res.q = value_type(1);
+            res.base = base;
+            if (res.size() > 2 * base + reduce_slack)
+                res.normalize();
+            return res;
+        }
+
+        static basic_rational add_signed(const basic_rational &x, const basic_rational &y, int sign_y) {
+            int base = std::max(x.base, y.base);
+            value_type c = sign_y < 0 ? -y.p : y.p;
+            if (x.q == y.q)
+                return lazy(x.p + c, x.q, base);
+            return lazy(x.p * y.q + c * x.q, x.q * y.q, base);
+        }
+
+        basic_rational operator+(const basic_rational &v) const {
+            return add_signed(*this, v, 1);
+        }
+
+        basic_rational operator-(const basic_rational &v) const {
+            return add_signed(*this, v, -1);
+        }
+
+        basic_rational operator-() const {
+            basic_rational res = *this;
+            res.p = -res.p;
+            return res;
+        }
+
+        // x * y, or x / y when invert; with a/b and c/d the operands in lowest terms, the result is too
+        static basic_rational multiply(const basic_rational &x, const basic_rational &y, bool invert) {
+            const value_type &c = invert ? y.q : y.p, &d = invert ? y.p : y.q;
+            if (x.p.a.empty() || c.a.empty())
+                return basic_rational();
+            basic_rational res;
+            if (!x.reduced || !y.reduced) {
+                res = lazy(x.p * c, x.q * d, std::max(x.base, y.base));
+            } else {
+                value_type g1 = gcd(x.p, d), g2 = gcd(c, x.q), one(1);
+                res.p = (g1 == one ? x.p : x.p / g1) * (g2 == one ? c : c / g2);
+                res.q = (g2 == one ? x.q : x.q / g2) * (g1 == one ? d : d / g1);
+                res.base = res.size();
+            }
+            if (res.q.sign < 0) {
+                res.p = -res.p;
+                res.q = -res.q;
+            }
+            return res;
+        }
+
+        basic_rational operator*(const basic_rational &v) const {
+            return multiply(*this, v, false);
+        }
+
+        basic_rational operator/(const basic_rational &v) const {
+            return multiply(*this, v, true);
+        }
+
+        void operator+=(const basic_rational &v) {
+            *this = *this + v;
+        }
+
+        void operator-=(const basic_rational &v) {
+            *this = *this - v;
+        }
+
+        void operator*=(const basic_rational &v) {
+            *this = *this * v;
+        }
+
+        void operator/=(const basic_rational &v) {
+            *this = *this / v;
+        }
+
+        static int cmp(const basic_rational &x, const basic_rational &y) {
+            x.normalize();
+            y.normalize();
+            if (x.q == y.q)
+                return x.p < y.p ? -1 : y.p < x.p;
+            value_type l = x.p * y.q, r = y.p * x.q;
+            return l < r ? -1 : r < l;
+        }
+
+        bool operator<(const basic_rational &v) const {
+            return cmp(*this, v) < 0;
+        }
+
+        bool operator>(const basic_rational &v) const {
+            return cmp(*this, v) > 0;
+        }
+
+        bool operator<=(const basic_rational &v) const {
+            return cmp(*this, v) <= 0;
+        }
+
+        bool operator>=(const basic_rational &v) const {
+            return cmp(*this, v) >= 0;
+        }
+
+        bool operator==(const basic_rational &v) const {
+            return cmp(*this, v) == 0;
+        }
+
+        bool operator!=(const basic_rational &v) const {
+            return cmp(*this, v) != 0;
+        }
+
+        // "p" or "p/q"
+        void read(const std::string &s) {
+            size_t slash = s.find('/');
+            *this = slash == std::string::npos ? basic_rational(value_type(s))
+                                               : basic_rational(value_type(s.substr(0, slash)), value_type(s.substr(slash + 1)));
+        }
+
+        friend std::istream &operator>>(std::istream &stream, basic_rational &v) {
+            std::string s;
+            stream >> s;
+            v.read(s);
+            return stream;
+        }
+
+        friend std::ostream &operator<<(std::ostream &stream, const basic_rational &v) {
+            v.normalize();
+            stream << v.p;
+            if (!(v.q == value_type(1)))
+                stream << '/' << v.q;
+            return stream;
+        }
+    };
+
+    typedef basic_rational<decimal_limbs> rational;
+    typedef basic_rational<binary_limbs> binary_rational;
+
+#ifdef LINUX
+    // a read-only bigint mapped straight from a file in basic_bigint's binary format, without copying
+    // the limbs; the mapping lives as long as the view. Little-endian hosts only, elsewhere open fails
+    template<typename L>
+    struct basic_bigint_view {
+        typedef typename L::limb limb;
+        typedef basic_bigint<L> value_type;
+
+        void *map;
+        size_t length;
+        const limb *limbs;
+        size_t n;
+        int sign;
+
+        basic_bigint_view() :
+                map(nullptr), length(0), limbs(nullptr), n(0), sign(1) {
+        }
+
+        basic_bigint_view(const basic_bigint_view &) = delete;
+
+        basic_bigint_view &operator=(const basic_bigint_view &) = delete;
+
+        ~basic_bigint_view() {
+            close();
+        }
+
+        // maps the file at path, false if it cannot be mapped or is not a valid file for these limbs
+        bool open(const char *path) {
+            close();
+            if (!value_type::little_endian())
+                return false;
+            int fd = ::open(path, O_RDONLY);
+            if (fd < 0)
+                return false;
+            struct stat st;
+            bool ok = fstat(fd, &st) == 0 && st.st_size >= value_type::file_header;
+            if (ok) {
+                length = st.st_size;
+                map = mmap(nullptr, length, PROT_READ, MAP_SHARED, fd, 0);
+                ok = map != MAP_FAILED;
+                if (!ok)
+                    map = nullptr;
+            }
+            ::close(fd);
+            uint64 count;
+            if (!ok || !value_type::read_header((const char *) map, sign, count)
+                || count > (length - value_type::file_header) / sizeof(limb)) {
+                close();
+                return false;
+            }
+            limbs = (const limb *) ((const char *) map + value_type::file_header);
+            // decimal limbs out of range are rejected as load rejects them
+            if (L::decimal)
+                for (uint64 i = 0; i < count; i++)
+                    if (limbs[i] >= L::base()) {
+                        close();
+                        return false;
+                    }
+            // leading zero limbs are not part of the value
+            for (n = count; n > 0 && !limbs[n - 1]; n--);
+            return true;
+        }
+
+        void close() {
+            if (map)
+                munmap(map, length);
+            map = nullptr, length = 0, limbs = nullptr, n = 0, sign = 1;
+        }
+
+        // a copy of the mapped value as an ordinary bigint
+        value_type value() const {
+            value_type res;
+            res.a.assign(limbs, limbs + n);
+            res.sign = sign;
+            res.trim();
+            return res;
+        }
+    };
 
-            float64 number = 0;
+    typedef basic_bigint_view<decimal_limbs> bigint_view;
+    typedef basic_bigint_view<binary_limbs> binary_bigint_view;
+#endif
 
-            c = *(str++);
-            if (c == '-') {
-                negative = true;
+    // modular arithmetic for a fixed modulus m > 0. powmod works in Montgomery form when m is
+    // coprime to the limb base, otherwise (and for single mulmod/sqrmod) it divides by the
+    // pre-normalized modulus. Intermediates never exceed 2n + 1 limbs for an n-limb modulus
+    template<typename L>
+    struct basic_mod_context {
+        typedef basic_bigint<L> value_type;
+        typedef typename L::limb limb;
+        typedef typename L::dlimb dlimb;
+        typedef __mpn<L> K;
+
+        value_type mod;
+        int n;
+        bool montgomery;
+        limb minv, norm;
+        // modulus limbs, the normalized modulus and R^2 mod m for R = base^n
+        std::vector<limb> m, mn, r2;
+
+        // per-call buffers: a double-length product, multiplication scratch, a quotient
+        struct workspace {
+            std::vector<limb> t, ws, q;
+
+            workspace(int n) :
+                    t(2 * n + 1), ws(K::mul_scratch(n, n)), q(n + 1) {
             }
+        };
 
-            if (c == '-' || c == '+')
-                c = *(str++);
-
-            for (; (c > 47 && c < 58); c = *(str++))
-                number = number * 10 + c - 48;
+        explicit basic_mod_context(const value_type &v) :
+                mod(v.abs()), n(mod.a.size()) {
+            m.assign(mod.a.begin(), mod.a.end());
+            norm = K::normalizer(m.back());
+            mn.resize(n);
+            K::normalize(mn.data(), m.data(), n, norm);
+            montgomery = L::decimal ? m[0] % 2 && m[0] % 5 : m[0] & 1;
+            if (montgomery) {
+                minv = neg_inverse(m[0]);
+                r2 = reduce_value(value_type(1).shift_limbs(2 * n));
+            }
+        }
 
-            if (c == '.') {
-                c = *(str++);
-                for (double i = 1; c > 47 && c < 58; c = *(str++))
-                    number += (i /= 10) * (c - 48);
-            }
-
-            if (c == 'e' || c == 'E') {
-                long pow = int_from_string(str);
-                if (pow > 0) {
-                    while (pow-- > 0)
-                        number *= 10;
-                } else if (pow < 0) {
-                    while (pow++ < 0)
-                        number /= 10;
+        // -x^-1 modulo the limb base, x coprime to it
+        static limb neg_inverse(limb x) {
+            if (L::decimal) {
+                int64 r0 = L::base(), r1 = x, s0 = 0, s1 = 1;
+                while (r1) {
+                    int64 q = r0 / r1, t = r0 - q * r1;
+                    r0 = r1, r1 = t;
+                    t = s0 - q * s1;
+                    s0 = s1, s1 = t;
                 }
+                return limb(s0 > 0 ? L::base() - s0 : -s0);
             }
+            // Newton's iteration doubles the correct low bits, x * x = 1 mod 8 for odd x
+            limb inv = x;
+            for (int i = 0; i < 5; i++)
+                inv *= 2 - x * inv;
+            return -inv;
+        }
 
-            if (negative)
-                number *= -1;
-            return number;
+        // r = t mod m for t in w.t (2n limbs), destroys w.t
+        void reduce(limb *r, workspace &w) const {
+            limb *t = w.t.data();
+            t[2 * n] = K::normalize(t, t, 2 * n, norm);
+            K::divrem(w.q.data(), t, 2 * n + 1, mn.data(), n);
+            K::denormalize(r, t, n, norm);
         }
-    }
 
-    struct bigint {
-        std::vector<int> a;
-        int sign;
+        // r = t / R mod m for t < m * R in w.t (2n limbs), destroys w.t
+        void redc(limb *r, workspace &w) const {
+            limb *t = w.t.data();
+            t[2 * n] = 0;
+            for (int i = 0; i < n; i++) {
+                limb q = L::low((dlimb) t[i] * minv);
+                limb carry = K::addmul_1(t + i, m.data(), n, q);
+                K::add_1(t + i + n, t + i + n, n + 1 - i, carry);
+            }
+            if (t[2 * n] || K::cmp(t + n, m.data(), n) >= 0)
+                K::sub_n(r, t + n, m.data(), n);
+            else
+                std::copy(t + n, t + 2 * n, r);
+        }
 
-        bigint() :
-                sign(1) {
+        // r = x * y in the working representation; r may alias x or y
+        void mul(limb *r, const limb *x, const limb *y, workspace &w) const {
+            K::mul(w.t.data(), x, n, y, n, w.ws.data());
+            if (montgomery)
+                redc(r, w);
+            else
+                reduce(r, w);
         }
 
-        bigint(long long v) {
-            *this = v;
+        // x mod m as exactly n limbs
+        std::vector<limb> reduce_value(const value_type &x) const {
+            value_type v = x;
+            if (x.sign < 0 || cmp_abs(x) >= 0) {
+                v = x % mod;
+                if (v.sign < 0)
+                    v += mod;
+            }
+            std::vector<limb> res(v.a.begin(), v.a.end());
+            res.resize(n);
+            return res;
         }
 
-        bigint(const std::string &s) {
-            read(s);
+        int cmp_abs(const value_type &x) const {
+            return value_type::cmp_abs(x.a, mod.a);
         }
 
-        bigint& operator=(const bigint &v) = default;
+        value_type to_value(const limb *x) const {
+            value_type res;
+            res.a.assign(x, x + n);
+            res.trim();
+            return res;
+        }
 
-        bigint& operator=(long long v) {
-            sign = 1;
-            if (v < 0)
-                sign = -1, v = -v;
-            for (; v > 0; v = v / bigint_base)
-                a.push_back(v % bigint_base);
-            return *this;
+        value_type mulmod(const value_type &x, const value_type &y) const {
+            workspace w(n);
+            std::vector<limb> xr = reduce_value(x), yr = reduce_value(y);
+            K::mul(w.t.data(), xr.data(), n, yr.data(), n, w.ws.data());
+            reduce(xr.data(), w);
+            return to_value(xr.data());
         }
 
-        bigint operator+(const bigint &v) const {
-            if (sign == v.sign) {
-                bigint res = v;
+        value_type sqrmod(const value_type &x) const {
+            workspace w(n);
+            std::vector<limb> xr = reduce_value(x);
+            K::mul(w.t.data(), xr.data(), n, xr.data(), n, w.ws.data());
+            reduce(xr.data(), w);
+            return to_value(xr.data());
+        }
 
-                for (int i = 0, carry = 0; i < (int) std::max(a.size(), v.a.size()) || carry; ++i) {
-                    if (i == (int) res.a.size())
-                        res.a.push_back(0);
-                    res.a[i] += carry + (i < (int) a.size() ? a[i] : 0);
-                    carry = res.a[i] >= bigint_base;
-                    if (carry)
-                        res.a[i] -= bigint_base;
+        // bits of e >= 0, least significant first
+        static std::vector<bool> bits(const value_type &e) {
+            std::vector<bool> res;
+            if (!L::decimal) {
+                for (int i = 0; i < (int) e.a.size(); i++)
+                    for (int j = 0; j < K::limb_bits; j++)
+                        res.push_back(e.a[i] >> j & 1);
+            } else {
+                typename value_type::limbs x = e.a;
+                while (!x.empty()) {
+                    limb d = K::divrem_1(x.data(), x.data(), x.size(), 1 << 16);
+                    for (int j = 0; j < 16; j++)
+                        res.push_back(d >> j & 1);
+                    while (!x.empty() && !x.back())
+                        x.pop_back();
                 }
-                return res;
             }
-            return *this - (-v);
+            while (!res.empty() && !res.back())
+                res.pop_back();
+            return res;
         }
 
-        bigint operator-(const bigint &v) const {
-            if (sign == v.sign) {
-                if (abs() >= v.abs()) {
-                    bigint res = *this;
-                    for (int i = 0, carry = 0; i < (int) v.a.size() || carry; ++i) {
-                        res.a[i] -= carry + (i < (int) v.a.size() ? v.a[i] : 0);
-                        carry = res.a[i] < 0;
-                        if (carry)
-                            res.a[i] += bigint_base;
-                    }
-                    res.trim();
-                    return res;
+        // sliding-window x^e into r, x and r in the working representation
+        void pow(limb *r, const limb *x, const std::vector<bool> &e, workspace &w) const {
+            int b = e.size();
+            int k = b <= 7 ? 1 : b <= 25 ? 2 : b <= 81 ? 3 : b <= 241 ? 4 : b <= 673 ? 5 : b <= 1793 ? 6 : 7;
+            // odd powers x, x^3, ..., x^(2^k - 1)
+            std::vector<limb> odd(n << (k - 1));
+            std::copy(x, x + n, odd.begin());
+            if (k > 1) {
+                std::vector<limb> x2(n);
+                mul(x2.data(), x, x, w);
+                for (int i = 1; i < 1 << (k - 1); i++)
+                    mul(&odd[i * n], &odd[(i - 1) * n], x2.data(), w);
+            }
+            bool one = true;
+            for (int i = b - 1; i >= 0;) {
+                if (!e[i]) {
+                    mul(r, r, r, w);
+                    i--;
+                    continue;
                 }
-                return -(v - *this);
+                int j = std::max(i - k + 1, 0), v = 0;
+                while (!e[j])
+                    j++;
+                for (int t = i; t >= j; t--) {
+                    v = v * 2 + e[t];
+                    if (!one)
+                        mul(r, r, r, w);
+                }
+                if (one)
+                    std::copy(&odd[(v >> 1) * n], &odd[(v >> 1) * n] + n, r);
+                else
+                    mul(r, r, &odd[(v >> 1) * n], w);
+                one = false;
+                i = j - 1;
             }
-            return *this + (-v);
         }
 
-        void operator*=(int v) {
-            if (v < 0)
-                sign = -sign, v = -v;
-            for (int i = 0, carry = 0; i < (int) a.size() || carry; ++i) {
-                if (i == (int) a.size())
-                    a.push_back(0);
-                long long cur = a[i] * (long long) v + carry;
-                carry = (int) (cur / bigint_base);
-                a[i] = (int) (cur % bigint_base);
-                //asm("divl %%ecx" : "=a"(carry), "=d"(a[i]) : "A"(cur), "c"(bigint_base));
-            }
-            trim();
+        // x^e mod m; a negative e raises the inverse of x, which is 0 when x is not invertible
+        value_type powmod(const value_type &x, const value_type &e) const {
+            return powmod(std::vector<value_type>(1, x), e)[0];
         }
 
-        bigint operator*(int v) const {
-            bigint res = *this;
-            res *= v;
+        // x^e mod m for every x in xs, sharing the exponent scan and the buffers
+        std::vector<value_type> powmod(const std::vector<value_type> &xs, const value_type &e) const {
+            std::vector<bool> eb = bits(e.abs());
+            std::vector<value_type> res;
+            if (eb.empty()) {
+                res.assign(xs.size(), value_type(1) % mod);
+                return res;
+            }
+            workspace w(n);
+            std::vector<limb> r(n);
+            for (int i = 0; i < (int) xs.size(); i++) {
+                std::vector<limb> x = reduce_value(e.sign < 0 ? modinv(xs[i], mod) : xs[i]);
+                if (montgomery)
+                    mul(x.data(), x.data(), r2.data(), w);
+                pow(r.data(), x.data(), eb, w);
+                if (montgomery) {
+                    std::fill(w.t.begin(), w.t.end(), 0);
+                    std::copy(r.begin(), r.end(), w.t.begin());
+                    redc(r.data(), w);
+                }
+                res.push_back(to_value(r.data()));
+            }
             return res;
         }
+    };
 
-        friend std::pair<bigint, bigint> divmod(const bigint &a1, const bigint &b1) {
-            int norm = bigint_base / (b1.a.back() + 1);
-            bigint a = a1.abs() * norm;
-            bigint b = b1.abs() * norm;
-            bigint q, r;
-            q.a.resize(a.a.size());
+    typedef basic_mod_context<decimal_limbs> mod_context;
+    typedef basic_mod_context<binary_limbs> binary_mod_context;
 
-            for (int i = a.a.size() - 1; i >= 0; i--) {
-                r *= bigint_base;
-                r += a.a[i];
-                int s1 = r.a.size() <= b.a.size() ? 0 : r.a[b.a.size()];
-                int s2 = r.a.size() <= b.a.size() - 1 ? 0 : r.a[b.a.size() - 1];
-                int d = ((long long) bigint_base * s1 + s2) / b.a.back();
-                r -= b * d;
-                while (r < 0)
-                    r += b, --d;
-                q.a[i] = d;
-            }
+    // timings of the bigint operations over a sweep of operand sizes, and a tuner that measures the
+    // algorithm crossovers on this machine and prints them as a header for BIGINT_THRESHOLDS
+    template<typename L>
+    struct basic_bigint_benchmark {
+        typedef basic_bigint<L> value_type;
+        typedef typename L::limb limb;
+        typedef __mpn<L> K;
 
-            q.sign = a1.sign * b1.sign;
-            r.sign = a1.sign;
-            q.trim();
-            r.trim();
-            return std::make_pair(q, r / norm);
-        }
+        // nanoseconds per call over the repeats
+        struct sample {
+            double min, median, max;
+        };
 
-        bigint operator/(const bigint &v) const {
-            return divmod(*this, v).first;
+        int repeats;
+        // shortest duration of one repeat; fast calls run in a loop until they fill it
+        double min_time;
+        uint64 state;
+        volatile uint64 sink;
+
+        basic_bigint_benchmark(int repeats = 5, double min_time = 0.01) :
+                repeats(repeats), min_time(min_time), state(88172645463325252ull), sink(0) {
         }
 
-        bigint operator%(const bigint &v) const {
-            return divmod(*this, v).second;
+        limb random_limb() {
+            state ^= state << 13;
+            state ^= state >> 7;
+            state ^= state << 17;
+            return L::decimal ? limb(state % uint64(L::base())) : limb(state);
         }
 
-        void operator/=(int v) {
-            if (v < 0)
-                sign = -sign, v = -v;
-            for (int i = (int) a.size() - 1, rem = 0; i >= 0; --i) {
-                long long cur = a[i] + rem * (long long) bigint_base;
-                a[i] = (int) (cur / v);
-                rem = (int) (cur % v);
-            }
-            trim();
+        std::vector<limb> random_limbs(int n) {
+            std::vector<limb> x(n);
+            for (int i = 0; i < n; i++)
+                x[i] = random_limb();
+            if (x[n - 1] == 0)
+                x[n - 1] = 1;
+            return x;
         }
 
-        bigint operator/(int v) const {
-            bigint res = *this;
-            res /= v;
+        value_type random(int n) {
+            std::vector<limb> x = random_limbs(n);
+            value_type res;
+            res.a.assign(x.data(), x.data() + n);
             return res;
         }
 
-        int operator%(int v) const {
-            if (v < 0)
-                v = -v;
-            int m = 0;
-            for (int i = a.size() - 1; i >= 0; --i)
-                m = (a[i] + m * (long long) bigint_base) % v;
-            return m * sign;
+        template<typename F>
+        static double seconds(F &f, int count) {
+            auto start = std::chrono::high_resolution_clock::now();
+            for (int i = 0; i < count; i++)
+                f();
+            std::chrono::duration<double> elapsed = std::chrono::high_resolution_clock::now() - start;
+            return elapsed.count();
         }
 
-        void operator+=(const bigint &v) {
-            *this = *this + v;
+        template<typename F>
+        sample measure(F f) {
+            int count = 1;
+            while (seconds(f, count) < min_time)
+                count *= 2;
+            std::vector<double> t(repeats);
+            for (int i = 0; i < repeats; i++)
+                t[i] = seconds(f, count) / count * 1e9;
+            std::sort(t.begin(), t.end());
+            return sample{t[0], t[repeats / 2], t[repeats - 1]};
         }
 
-        void operator-=(const bigint &v) {
-            *this = *this - v;
+        void report(std::ostream &out, const char *op, int n, const sample &s) {
+            out << std::left << std::setw(8) << op << std::right << std::setw(8) << n << std::fixed << std::setprecision(1)
+                << std::setw(14) << s.min << std::setw(14) << s.median << std::setw(14) << s.max
+                << std::setprecision(3) << std::setw(12) << s.median / n << '\n';
         }
 
-        void operator*=(const bigint &v) {
-            *this = *this * v;
+        // ns/limb of add, mul, sqr, divmod (2n by n limbs), gcd, pow (an n-limb result) and decimal
+        // read/write for n = 1, 2, 4, ... up to max_limbs
+        void run(std::ostream &out, int max_limbs = 8192) {
+            out << (L::decimal ? "decimal" : "binary") << " limbs, " << repeats << " repeats\n"
+                << std::left << std::setw(8) << "op" << std::right << std::setw(8) << "limbs" << std::setw(14) << "min ns"
+                << std::setw(14) << "median ns" << std::setw(14) << "max ns" << std::setw(12) << "ns/limb" << '\n';
+            for (int n = 1; n <= max_limbs; n *= 2) {
+                value_type x = random(n), y = random(n), u = random(2 * n), b = random(std::max(1, n / 16));
+                int e = n / b.a.size();
+                std::string s(x.chars_length(), '0');
+                s.resize(x.to_chars(&s[0]) - s.data());
+                report(out, "add", n, measure([&] { sink += (x + y).a.size(); }));
+                report(out, "mul", n, measure([&] { sink += (x * y).a.size(); }));
+                report(out, "sqr", n, measure([&] { sink += x.sqr().a.size(); }));
+                report(out, "divmod", n, measure([&] { sink += divmod(u, x).first.a.size(); }));
+                report(out, "gcd", n, measure([&] { sink += gcd(x, y).a.size(); }));
+                report(out, "pow", n, measure([&] { sink += b.pow(e).a.size(); }));
+                report(out, "read", n, measure([&] { value_type v(s); sink += v.a.size(); }));
+                report(out, "write", n, measure([&] { sink += x.to_chars(&s[0]) - s.data(); }));
+            }
         }
 
-        void operator/=(const bigint &v) {
-            *this = *this / v;
+        // first of three consecutive sizes at which faster(n) reports less time than slower(n), or -1
+        template<typename F>
+        int crossover(int from, int to, F time) {
+            int wins = 0, first = -1;
+            for (int n = from; n <= to; n += std::max(1, n / 16)) {
+                if (time(n, true) < time(n, false)) {
+                    if (wins++ == 0)
+                        first = n;
+                    if (wins == 3)
+                        return first;
+                } else {
+                    wins = 0;
+                }
+            }
+            return -1;
         }
 
-        bool operator<(const bigint &v) const {
-            if (sign != v.sign)
-                return sign < v.sign;
-            if (a.size() != v.a.size())
-                return a.size() * sign < v.a.size() * v.sign;
-            for (int i = a.size() - 1; i >= 0; i--)
-                if (a[i] != v.a[i])
-                    return a[i] * sign < v.a[i] * sign;
-            return false;
+        // scratch of one Karatsuba or Toom-3 level on top of the compiled tiers
+        static int karatsuba_scratch(int n) {
+            int k = n / 2, h = n - k;
+            return std::max(std::max(K::mul_n_scratch(k), K::mul_n_scratch(h)), 4 * (h + 1) + K::mul_n_scratch(h + 1));
         }
 
-        bool operator>(const bigint &v) const {
-            return v < *this;
+        static int toom3_scratch(int n) {
+            int k = (n + 2) / 3, h = n - 2 * k;
+            return 8 * (k + 1) + std::max(std::max(K::mul_n_scratch(k), K::mul_n_scratch(h)), K::mul_n_scratch(k + 1));
         }
 
-        bool operator<=(const bigint &v) const {
-            return !(v < *this);
+        // the tiers below each candidate use the compiled thresholds, and Newton division recurses down to
+        // the candidate itself, so the header converges when the tuner is rerun against its own output.
+        // Sizes where a faster tier never wins give the range end
+        void tune(std::ostream &out) {
+            int karatsuba = crossover(4, 256, [&](int n, bool fast) {
+                std::vector<limb> x = random_limbs(n), y = random_limbs(n), r(2 * n), ws(karatsuba_scratch(n));
+                if (fast)
+                    return measure([&] { K::karatsuba_mul(r.data(), x.data(), y.data(), n, ws.data()); }).median;
+                return measure([&] { K::basecase_mul(r.data(), x.data(), n, y.data(), n); }).median;
+            });
+            int toom3 = crossover(32, 1024, [&](int n, bool fast) {
+                std::vector<limb> x = random_limbs(n), y = random_limbs(n), r(2 * n);
+                std::vector<limb> ws(std::max(karatsuba_scratch(n), toom3_scratch(n)));
+                if (fast)
+                    return measure([&] { K::toom3_mul(r.data(), x.data(), y.data(), n, ws.data()); }).median;
+                return measure([&] { K::karatsuba_mul(r.data(), x.data(), y.data(), n, ws.data()); }).median;
+            });
+            int ntt = crossover(500, 100000, [&](int n, bool fast) {
+                std::vector<limb> x = random_limbs(n), y = random_limbs(n), r(2 * n), ws(K::mul_n_scratch(n));
+                if (fast)
+                    return measure([&] { K::ntt_mul(r.data(), x.data(), n, y.data(), n); }).median;
+                return measure([&] { K::mul_n(r.data(), x.data(), y.data(), n, ws.data()); }).median;
+            });
+            int division = crossover(16, 8192, [&](int n, bool fast) {
+                // 2n by n limbs, normalized the way divmod does before it picks an algorithm
+                std::vector<limb> u0 = random_limbs(2 * n), v0 = random_limbs(n), u(2 * n + 1), v(n), q(n + 1);
+                limb f = K::normalizer(v0.back());
+                u.back() = K::normalize(u.data(), u0.data(), 2 * n, f);
+                K::normalize(v.data(), v0.data(), n, f);
+                if (fast) {
+                    value_type a, b, qt, rt;
+                    a.a.assign(u.data(), u.data() + u.size());
+                    b.a.assign(v.data(), v.data() + n);
+                    a.trim();
+                    return measure([&] { value_type::newton_divmod(a, b, qt, rt, n); }).median;
+                }
+                std::vector<limb> w(u);
+                return measure([&] {
+                    std::copy(u.begin(), u.end(), w.begin());
+                    K::divrem(q.data(), w.data(), 2 * n + 1, v.data(), n);
+                }).median;
+            });
+            const char *kind = L::decimal ? "DECIMAL" : "BINARY";
+            out << "#define BIGINT_" << kind << "_KARATSUBA_THRESHOLD " << (karatsuba < 0 ? 256 : karatsuba - 1) << '\n'
+                << "#define BIGINT_" << kind << "_TOOM3_THRESHOLD " << (toom3 < 0 ? 1024 : toom3) << '\n'
+                << "#define BIGINT_" << kind << "_NTT_THRESHOLD " << (ntt < 0 ? 100000 : ntt) << '\n'
+                << "#define BIGINT_" << kind << "_DIVISION_THRESHOLD " << (division < 0 ? 8192 : division) << '\n';
         }
+    };
 
-        bool operator>=(const bigint &v) const {
-            return !(*this < v);
-        }
+    typedef basic_bigint_benchmark<decimal_limbs> bigint_benchmark;
+    typedef basic_bigint_benchmark<binary_limbs> binary_bigint_benchmark;
 
-        bool operator==(const bigint &v) const {
-            return !(*this < v) && !(v < *this);
-        }
+    // std::istream has no 128-bit integer extraction; the token wraps like the fast reader's integers
+    template<typename T, typename U>
+    std::istream &__read_int128(std::istream &stream, T &v) {
+        std::string s;
+        if (!(stream >> s))
+            return stream;
+        const char *p = s.c_str();
+        bool negative = *p == '-';
+        if (*p == '-' || *p == '+')
+            p++;
+        U value = 0;
+        for (unsigned d; (d = unsigned(*p - '0')) < 10; p++)
+            value = value * 10 + d;
+        v = T(negative ? U(0) - value : value);
+        return stream;
+    }
 
-        bool operator!=(const bigint &v) const {
-            return *this < v || v < *this;
-        }
+    std::istream &operator>>(std::istream &stream, __int128 &v) {
+        return __read_int128<__int128, unsigned __int128>(stream, v);
+    }
 
-        void trim() {
-            while (!a.empty() && !a.back())
-                a.pop_back();
-            if (a.empty())
-                sign = 1;
-        }
+    std::istream &operator>>(std::istream &stream, unsigned __int128 &v) {
+        return __read_int128<unsigned __int128, unsigned __int128>(stream, v);
+    }
 
-        bool is_zero() const {
-            return a.empty() || (a.size() == 1 && !a[0]);
+    // input read from a file descriptor: a regular file is mapped whole when mapping is allowed, anything
+    // else is refilled block by block with read(2). At least `padding` zero bytes always follow the data,
+    // so scans over [cur, end) stop at the end without a separate bounds check and word-wide loads near
+    // the end stay in bounds; tokens that straddle a refill are continued from the next block
+    struct __input_buffer {
+        static const int capacity = 1 << 16, padding = 64;
+
+        int fd;
+        bool owned, mappable, eof;
+        char *block, *cur, *end;
+        size_t block_size;
+        char *map;
+        size_t map_length;
+
+        explicit __input_buffer(int fd) :
+                fd(fd), owned(false), mappable(true), eof(false), block(new char[capacity + padding]),
+                cur(block), end(block), block_size(capacity), map(nullptr), map_length(0) {
+            std::memset(end, 0, padding);
         }
 
-        bigint operator-() const {
-            bigint res = *this;
-            res.sign = -sign;
-            return res;
-        }
+        __input_buffer(const __input_buffer &) = delete;
 
-        bigint abs() const {
-            bigint res = *this;
-            res.sign *= res.sign;
-            return res;
+        __input_buffer &operator=(const __input_buffer &) = delete;
+
+        ~__input_buffer() {
+            unmap();
+            close();
+            delete[] block;
         }
 
-        long long long_value() const {
-            long long res = 0;
-            for (int i = a.size() - 1; i >= 0; i--)
-                res = res * bigint_base + a[i];
-            return res * sign;
+        // switches to another descriptor, closed with the buffer when owned
+        void reset(int new_fd, bool own) {
+            unmap();
+            close();
+            fd = new_fd;
+            owned = own;
+            eof = false;
+            cur = end = block;
+            std::memset(end, 0, padding);
         }
 
-        friend bigint gcd(const bigint &a, const bigint &b) {
-            return b.is_zero() ? a : gcd(b, a % b);
+        void close() {
+            if (!owned)
+                return;
+#ifdef LINUX
+            ::close(fd);
+#else
+            ::_close(fd);
+#endif
+            owned = false;
         }
 
-        friend bigint lcm(const bigint &a, const bigint &b) {
-            return a / gcd(a, b) * b;
+        void unmap() {
+#ifdef LINUX
+            if (map)
+                munmap(map, map_length);
+#endif
+            map = nullptr;
         }
 
-        bigint pow(bigint b) const {
-            bigint result(1);
-            bigint a = *this;
-            while (b > 0) {
-                if (b % 2 == 1) {
-                    result *= a;
-                }
-                b /= 2;
-                a *= a;
+        // maps the rest of a regular file behind the cursor; the page reserved after it reads as zeros
+        // and stands in for the padding, which cannot be written into a read-only mapping
+        bool map_rest() {
+#ifdef LINUX
+            struct stat st;
+            if (fstat(fd, &st) != 0 || !S_ISREG(st.st_mode))
+                return false;
+            off_t offset = lseek(fd, 0, SEEK_CUR);
+            if (offset < 0 || offset >= st.st_size)
+                return false;
+            size_t page = sysconf(_SC_PAGESIZE), start = offset / page * page, length = st.st_size - start;
+            void *p = mmap(nullptr, length + page, PROT_READ, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+            if (p == MAP_FAILED)
+                return false;
+            if (mmap(p, length, PROT_READ, MAP_PRIVATE | MAP_FIXED, fd, start) == MAP_FAILED) {
+                munmap(p, length + page);
+                return false;
             }
-            return result;
+            madvise(p, length, MADV_SEQUENTIAL);
+            lseek(fd, st.st_size, SEEK_SET);
+            map = (char *) p;
+            map_length = length + page;
+            cur = map + (offset - start);
+            end = map + length;
+            return true;
+#else
+            return false;
+#endif
         }
 
-        bigint pow(long long b) const {
-            bigint result(1);
-            bigint a = *this;
-            while (b > 0) {
-                if (b % 2 == 1) {
-                    result *= a;
-                }
-                b /= 2;
-                a *= a;
-            }
-            return result;
+        // appends up to block_size - (end - block) bytes at end, false at the end of input
+        bool read_more() {
+            long n;
+            do {
+#ifdef LINUX
+                n = ::read(fd, end, block_size - (end - block));
+#else
+                n = ::_read(fd, end, unsigned(block_size - (end - block)));
+#endif
+            } while (n < 0 && errno == EINTR);
+            if (n <= 0)
+                eof = true, n = 0;
+            end += n;
+            std::memset(end, 0, padding);
+            return n > 0;
         }
 
-        bigint pow(long b) const {
-            bigint result(1);
-            bigint a = *this;
-            while (b > 0) {
-                if (b % 2 == 1) {
-                    result *= a;
-                }
-                b /= 2;
-                a *= a;
-            }
-            return result;
+        // replaces the consumed data with the next block, false at the end of input
+        bool refill() {
+            if (eof)
+                return false;
+            unmap();
+            if (mappable && map_rest())
+                return true;
+            cur = end = block;
+            return read_more();
         }
 
-        bigint pow(int b) const {
-            bigint result(1);
-            bigint a = *this;
-            while (b > 0) {
-                if (b % 2 == 1) {
-                    result *= a;
-                }
-                b /= 2;
-                a *= a;
+        // like refill, but keeps [cur, end) in front of the new data, so a token that straddles blocks
+        // becomes contiguous; the block doubles when the kept part fills it. A mapping already runs to
+        // the end of the file and cannot be extended
+        bool extend() {
+            if (eof || map)
+                return false;
+            size_t kept = end - cur;
+            if (kept > block_size / 2) {
+                char *grown = new char[2 * block_size + padding];
+                std::memcpy(grown, cur, kept);
+                delete[] block;
+                block = grown;
+                block_size *= 2;
+            } else {
+                std::memmove(block, cur, kept);
             }
-            return result;
+            cur = block;
+            end = block + kept;
+            return read_more();
         }
 
-        bigint operator^(bigint other) {
-            return pow(other);
+        static bool space(char c) {
+            return c == ' ' || unsigned(c - '\t') < 5;
         }
 
-        bigint operator^(long other) {
-            return pow(other);
+        // the first non-whitespace byte at or after p; runs longer than a separator are scanned 16 bytes
+        // at a time, which the padding allows since its zeros end every run
+        static char *past_space(char *p) {
+            if (!space(*p) || !space(*++p))
+                return p;
+#ifdef X86_SIMD
+            const __m128i blank = _mm_set1_epi8(' '), tab = _mm_set1_epi8('\t'), four = _mm_set1_epi8(4);
+            for (;; p += 16) {
+                __m128i c = _mm_loadu_si128((const __m128i *) p), t = _mm_sub_epi8(c, tab);
+                __m128i s = _mm_or_si128(_mm_cmpeq_epi8(c, blank), _mm_cmpeq_epi8(_mm_min_epu8(t, four), t));
+                unsigned m = ~unsigned(_mm_movemask_epi8(s)) & 0xFFFF;
+                if (m)
+                    return p + __builtin_ctz(m);
+            }
+#else
+            while (space(*p))
+                p++;
+            return p;
+#endif
         }
 
-        bigint operator^(long long other) {
-            return pow(other);
+        // the first character after any whitespace, not consumed, or -1 at the end of input
+        int skip_space() {
+            for (;;) {
+                cur = past_space(cur);
+                if (cur < end)
+                    return (unsigned char) *cur;
+                if (!refill())
+                    return -1;
+            }
         }
 
-        bigint operator^(int other) {
-            return pow(other);
+        // consumes one character if it is c
+        bool accept(char c) {
+            if (cur == end && !refill())
+                return false;
+            if (*cur != c)
+                return false;
+            cur++;
+            return true;
         }
 
-        void read(const std::string &s) {
-            sign = 1;
-            a.clear();
-            int pos = 0;
-            while (pos < (int) s.size() && (s[pos] == '-' || s[pos] == '+')) {
-                if (s[pos] == '-')
-                    sign = -sign;
-                ++pos;
-            }
-            for (int i = s.size() - 1; i >= pos; i -= bigint_base_digits) {
-                int x = 0;
-                for (int j = std::max(pos, i - bigint_base_digits + 1); j <= i; j++)
-                    x = x * 10 + s[j] - '0';
-                a.push_back(x);
+        // value * 10^k + the k digits at the cursor, wrapping like U, converted eight at a time
+        template<typename U>
+        U digits(U value) {
+            for (;;) {
+                const char *p = __swar_digits::run(cur, value);
+                cur = (char *) p;
+                if (p < end || !refill())
+                    return value;
             }
-            trim();
-        }
-
-        friend std::istream &operator>>(std::istream &stream, bigint &v) {
-            std::string s;
-            stream >> s;
-            v.read(s);
-            return stream;
         }
 
-        friend std::ostream &operator<<(std::ostream &stream, const bigint &v) {
-            if (v.sign == -1)
-                stream << '-';
-            stream << (v.a.empty() ? 0 : v.a.back());
-            for (int i = (int) v.a.size() - 2; i >= 0; --i)
-                stream << std::setw(bigint_base_digits) << std::setfill('0') << v.a[i];
-            return stream;
+        // the end of the complete tokens in [cur, end): just past the last whitespace, or end itself when no
+        // more input follows. Tokens before it can be parsed back to back without refill checks
+        char *complete_end() {
+            if (eof || map)
+                return end;
+            char *p = end;
+            while (p > cur && !space(p[-1]))
+                p--;
+            return p;
         }
 
-        static std::vector<int> convert_base(const std::vector<int> &a, int old_digits, int new_digits) {
-            std::vector<long long> p(std::max(old_digits, new_digits) + 1);
-            p[0] = 1;
-            for (int i = 1; i < (int) p.size(); i++)
-                p[i] = p[i - 1] * 10;
-            std::vector<int> res;
-            long long cur = 0;
-            int cur_digits = 0;
-            for (int i = 0; i < (int) a.size(); i++) {
-                cur += a[i] * p[cur_digits];
-                cur_digits += old_digits;
-                while (cur_digits >= new_digits) {
-                    res.push_back(int(cur % p[new_digits]));
-                    cur /= p[new_digits];
-                    cur_digits -= new_digits;
-                }
+        // the end of the token at the cursor, extending the buffer until the whole token is in it
+        char *token_end() {
+            char *p = cur;
+            for (;;) {
+                while (p < end && !space(*p))
+                    p++;
+                size_t length = p - cur;
+                if (p < end || !extend())
+                    return cur + length;
+                p = cur + length;
             }
-            res.push_back((int) cur);
-            while (!res.empty() && !res.back())
-                res.pop_back();
-            return res;
         }
 
-        typedef std::vector<long long> vll;
-
-        static vll karatsubaMultiply(const vll &a, const vll &b) {
-            int n = a.size();
-            vll res(n + n);
-            if (n <= 32) {
-                for (int i = 0; i < n; i++)
-                    for (int j = 0; j < n; j++)
-                        res[i + j] += a[i] * b[j];
-                return res;
-            }
-
-            int k = n >> 1;
-            vll a1(a.begin(), a.begin() + k);
-            vll a2(a.begin() + k, a.end());
-            vll b1(b.begin(), b.begin() + k);
-            vll b2(b.begin() + k, b.end());
+        // the characters up to the next whitespace
+        void token(std::string &s) {
+            char *p = token_end();
+            s.assign(cur, p);
+            cur = p;
+        }
+    };
 
-            vll a1b1 = karatsubaMultiply(a1, b1);
-            vll a2b2 = karatsubaMultiply(a2, b2);
+    // std::streambuf over the input buffer: the get area is the buffered data, and the cursor is handed
+    // back on destruction, so an extraction consumes exactly the characters it used
+    class __input_streambuf : public std::streambuf {
+    public:
+        explicit __input_streambuf(__input_buffer &in) :
+                in(in) {
+            setg(in.cur, in.cur, in.end);
+        }
 
-            for (int i = 0; i < k; i++)
-                a2[i] += a1[i];
-            for (int i = 0; i < k; i++)
-                b2[i] += b1[i];
-
-            vll r = karatsubaMultiply(a2, b2);
-            for (int i = 0; i < (int) a1b1.size(); i++)
-                r[i] -= a1b1[i];
-            for (int i = 0; i < (int) a2b2.size(); i++)
-                r[i] -= a2b2[i];
-
-            for (int i = 0; i < (int) r.size(); i++)
-                res[i + k] += r[i];
-            for (int i = 0; i < (int) a1b1.size(); i++)
-                res[i] += a1b1[i];
-            for (int i = 0; i < (int) a2b2.size(); i++)
-                res[i + n] += a2b2[i];
-            return res;
+        ~__input_streambuf() {
+            in.cur = gptr();
         }
 
-        bigint operator*(const bigint &v) const {
-            std::vector<int> a6 = convert_base(this->a, bigint_base_digits, 6);
-            std::vector<int> b6 = convert_base(v.a, bigint_base_digits, 6);
-            vll a(a6.begin(), a6.end());
-            vll b(b6.begin(), b6.end());
-            while (a.size() < b.size())
-                a.push_back(0);
-            while (b.size() < a.size())
-                b.push_back(0);
-            while (a.size() & (a.size() - 1))
-                a.push_back(0), b.push_back(0);
-            vll c = karatsubaMultiply(a, b);
-            bigint res;
-            res.sign = sign * v.sign;
-            for (int i = 0, carry = 0; i < (int) c.size(); i++) {
-                long long cur = c[i] + carry;
-                res.a.push_back((int) (cur % 1000000));
-                carry = (int) (cur / 1000000);
-            }
-            res.a = convert_base(res.a, 6, bigint_base_digits);
-            res.trim();
-            return res;
+    protected:
+        int_type underflow() {
+            in.cur = gptr();
+            if (in.cur == in.end && !in.refill())
+                return traits_type::eof();
+            setg(in.cur, in.cur, in.end);
+            return traits_type::to_int_type(*in.cur);
         }
+
+    private:
+        __input_buffer &in;
     };
 
+    // types without a parser of their own go through their operator>>, which may read any number of fields
     template<typename T>
     struct __fast_stdin_helper {
-        void read(T &var) {
-            std::cin >> var;
+        void read(__input_buffer &in, T &var) {
+            __input_streambuf buf(in);
+            std::istream stream(&buf);
+            stream >> var;
         }
     };
 
     template<>
-    struct __fast_stdin_helper<int> {
-        void read(int& number) {
-            bool negative = false;
-            int c;
-
-            number = 0;
+    struct __fast_stdin_helper<std::string> {
+        void read(__input_buffer &in, std::string &var) {
+            in.skip_space();
+            in.token(var);
+        }
+    };
 
-            while (std::isspace((unsigned char) (c = getchar()))) {}
+    template<typename T, typename U>
+    struct __fast_stdin_integer {
+        void read(__input_buffer &in, T &number) {
+            int c = in.skip_space();
+            bool negative = c == '-';
+            if (negative || c == '+')
+                in.cur++;
+            U value = in.digits(U(0));
+            number = T(negative ? U(0) - value : value);
+        }
 
-            //c = getchar();
-            if (c == '-') {
-                negative = true;
-                c = getchar();
+        // n values: the complete tokens of each block are parsed in one pass over the bytes, and only a
+        // token cut by the end of the block goes through read
+        void read_array(__input_buffer &in, T *dst, size_t n) {
+            for (size_t i = 0; i < n; i++) {
+                const char *p = in.cur, *safe = in.complete_end();
+                for (; i < n; i++) {
+                    p = __input_buffer::past_space((char *) p);
+                    if (p >= safe)
+                        break;
+                    bool negative = *p == '-';
+                    p += negative || *p == '+';
+                    U value = 0;
+                    p = __swar_digits::run(p, value);
+                    dst[i] = T(negative ? U(0) - value : value);
+                }
+                in.cur = (char *) p;
+                if (i < n)
+                    read(in, dst[i]);
             }
-
-            for (; (c > 47 && c < 58); c = getchar())
-                number = number * 10 + c - 48;
-
-            if (negative)
-                number *= -1;
         }
     };
 
     template<>
-    struct __fast_stdin_helper<long> {
-        void read(long& number) {
-            bool negative = false;
-            int c;
-
-            number = 0;
+    struct __fast_stdin_helper<int> : __fast_stdin_integer<int, unsigned> {
+    };
 
-            while (std::isspace((unsigned char) (c = getchar()))) {}
+    template<>
+    struct __fast_stdin_helper<long> : __fast_stdin_integer<long, unsigned long> {
+    };
 
-            //c = getchar();
-            if (c == '-') {
-                negative = true;
-                c = getchar();
-            }
+    template<>
+    struct __fast_stdin_helper<long long> : __fast_stdin_integer<long long, unsigned long long> {
+    };
 
-            for (; (c > 47 && c < 58); c = getchar())
-                number = number * 10 + c - 48;
+    // short types accumulate in unsigned int, which wraps where their promotion to int would overflow
+    template<>
+    struct __fast_stdin_helper<short> : __fast_stdin_integer<short, unsigned> {
+    };
 
-            if (negative)
-                number *= -1;
-        }
+    template<>
+    struct __fast_stdin_helper<unsigned short> : __fast_stdin_integer<unsigned short, unsigned> {
     };
 
     template<>
-    struct __fast_stdin_helper<long long> {
-        void read(long long& number) {
-            bool negative = false;
-            int c;
+    struct __fast_stdin_helper<unsigned> : __fast_stdin_integer<unsigned, unsigned> {
+    };
 
-            number = 0;
+    template<>
+    struct __fast_stdin_helper<unsigned long> : __fast_stdin_integer<unsigned long, unsigned long> {
+    };
 
-            while (std::isspace((unsigned char) (c = getchar()))) {}
+    template<>
+    struct __fast_stdin_helper<unsigned long long> : __fast_stdin_integer<unsigned long long, unsigned long long> {
+    };
 
-            //c = getchar();
-            if (c == '-') {
-                negative = true;
-                c = getchar();
-            }
+    template<>
+    struct __fast_stdin_helper<__int128> : __fast_stdin_integer<__int128, unsigned __int128> {
+    };
 
-            for (; (c > 47 && c < 58); c = getchar())
-                number = number * 10 + c - 48;
+    template<>
+    struct __fast_stdin_helper<unsigned __int128> : __fast_stdin_integer<unsigned __int128, unsigned __int128> {
+    };
 
-            if (negative)
-                number *= -1;
+    // characters are read like std::cin does: the next one that is not whitespace
+    template<typename C>
+    struct __fast_stdin_char {
+        void read(__input_buffer &in, C &c) {
+            int x = in.skip_space();
+            if (x >= 0) {
+                c = C(x);
+                in.cur++;
+            }
         }
     };
 
     template<>
-    struct __fast_stdin_helper<double> {
-        void read(double& number) {
-            bool negative = false;
-            int c;
-
-            number = 0;
+    struct __fast_stdin_helper<char> : __fast_stdin_char<char> {
+    };
 
-            while (std::isspace((unsigned char) (c = getchar()))) {}
+    template<>
+    struct __fast_stdin_helper<signed char> : __fast_stdin_char<signed char> {
+    };
 
-            //c = getchar();
-            if (c == '-') {
-                negative = true;
-                c = getchar();
-            }
+    template<>
+    struct __fast_stdin_helper<unsigned char> : __fast_stdin_char<unsigned char> {
+    };
 
-            for (; (c > 47 && c < 58); c = getchar())
-                number = number * 10 + c - 48;
+    // the limbs are built from the digits in the buffer
+    template<typename L>
+    struct __fast_stdin_helper<basic_bigint<L> > {
+        void read(__input_buffer &in, basic_bigint<L> &v) {
+            in.skip_space();
+            char *p = in.token_end();
+            v.read(in.cur, p);
+            in.cur = p;
+        }
+    };
 
-            if (c == '.') {
-                c = getchar();
-                for (double i = 1; c > 47 && c < 58; c = getchar())
-                    number += (i /= 10) * (c - 48);
-            }
+    template<typename F>
+    struct __fast_stdin_float {
+        void read(__input_buffer &in, F &number) {
+            in.skip_space();
+            char *p = in.token_end();
+            __decimal_to_float::parse(in.cur, number, true);
+            in.cur = p;
+        }
+    };
 
-            if (c == 'e' || c == 'E') {
-                long pow; __fast_stdin_helper<long>().read(pow);
-                if (pow > 0) {
-                    while (pow-- > 0)
-                        number *= 10;
-                } else if (pow < 0) {
-                    while (pow++ < 0)
-                        number /= 10;
-                }
-            }
+    template<>
+    struct __fast_stdin_helper<double> : __fast_stdin_float<double> {
+    };
 
-            if (negative)
-                number *= -1;
-        }
+    template<>
+    struct __fast_stdin_helper<float> : __fast_stdin_float<float> {
     };
 
     class fast_stdin {
     public:
-        fast_stdin() {
+        // mapped_mode parses a regular file in place through mmap and falls back to buffered_mode for pipes
+        // and terminals. buffered_mode parses blocks read straight from the descriptor. cin_mode sends every
+        // read through std::cin instead, so it follows rdbuf redirection and mixes with other cin readers;
+        // pick it before the first read, input already buffered is not handed over
+        enum mode {
+            mapped_mode, buffered_mode, cin_mode
+        };
+
+        explicit fast_stdin(int fd = 0) :
+                input(fd), current(mapped_mode) {
             std::ios_base::sync_with_stdio(false);
             std::ios::sync_with_stdio(false);
             std::cin.tie(0);
         }
 
+        void set_mode(mode m) {
+            current = m;
+            input.mappable = m == mapped_mode;
+        }
+
+        // reads the named file from now on instead of the descriptor; false if it cannot be opened
+        bool open(const std::string &filename) {
+#ifdef LINUX
+            int fd = ::open(filename.c_str(), O_RDONLY);
+#else
+            int fd = ::_open(filename.c_str(), _O_RDONLY | _O_BINARY);
+#endif
+            if (fd < 0)
+                return false;
+            input.reset(fd, true);
+            return true;
+        }
+
+        mode get_mode() const {
+            return current;
+        }
+
+        // true once only whitespace is left
+        bool eof() {
+            if (current == cin_mode)
+                return (std::cin >> std::ws).eof();
+            return input.skip_space() < 0;
+        }
+
         template<typename T>
         T read() {
             T result;
@@ -668,7 +5044,23 @@ namespace libs {
 
         template<typename T>
         fast_stdin &read(T &var) {
-            __fast_stdin_helper<T>().read(var);
+            if (current == cin_mode)
+                std::cin >> var;
+            else
+                __fast_stdin_helper<T>().read(input, var);
+            return *this;
+        }
+
+        // the next n values into dst, with the parser chosen once for the whole batch
+        template<typename T>
+        fast_stdin &read_array(T *dst, size_t n) {
+            if (current == cin_mode) {
+                for (size_t i = 0; i < n; i++)
+                    std::cin >> dst[i];
+                return *this;
+            }
+            __fast_stdin_helper<T> helper;
+            read_array(helper, dst, n, 0);
             return *this;
         }
 
@@ -676,6 +5068,22 @@ namespace libs {
         fast_stdin &operator>>(T &var) {
             return read(var);
         }
+
+    private:
+        __input_buffer input;
+        mode current;
+
+        // helpers with a batch parser of their own use it, the rest read value by value
+        template<typename H, typename T>
+        auto read_array(H &helper, T *dst, size_t n, int) -> decltype(helper.read_array(input, dst, n)) {
+            return helper.read_array(input, dst, n);
+        }
+
+        template<typename H, typename T>
+        void read_array(H &helper, T *dst, size_t n, long) {
+            for (size_t i = 0; i < n; i++)
+                helper.read(input, dst[i]);
+        }
     };
 
     class fast_stdout {
@@ -746,9 +5154,11 @@ namespace libs {
     class function {
     public:
         typedef Return (*ptr)(Args...);
-        typedef Return (__stdcall *ptr_stdcall)(Args...);
         typedef Return (&ref)(Args...);
+#ifdef WINDOWS
+        typedef Return (__stdcall *ptr_stdcall)(Args...);
         typedef Return (__stdcall &ref_stdcall)(Args...);
+#endif
 
     private:
         ptr pointer;
@@ -847,8 +5257,11 @@ namespace libs {
 
         void run(Args... args) {
             std::streambuf *cin_backup = std::cin.rdbuf();
+            fast_stdin::mode in_backup = in.get_mode();
             if (cin_buf) {
                 std::cin.rdbuf(cin_buf);
+                // libs::in reads the descriptor itself, so it has to go through cin to see the redirect
+                in.set_mode(fast_stdin::cin_mode);
             }
             if (!cin_buf_inited) {
                 std::cout << "WARNING: cin not inited, using standard input" << std::endl;
@@ -863,6 +5276,8 @@ namespace libs {
             auto start = std::chrono::high_resolution_clock::now();
             Return value = (*func)(args...);
             auto end = std::chrono::high_resolution_clock::now();
+            std::cin.rdbuf(cin_backup);
+            in.set_mode(in_backup);
             std::cout << std::endl;
             int errors = 0;
             int tests = 0;
@@ -956,8 +5371,11 @@ namespace libs {
 
         void run(Args... args) {
             std::streambuf *cin_backup = std::cin.rdbuf();
+            fast_stdin::mode in_backup = in.get_mode();
             if (cin_buf) {
                 std::cin.rdbuf(cin_buf);
+                // libs::in reads the descriptor itself, so it has to go through cin to see the redirect
+                in.set_mode(fast_stdin::cin_mode);
             }
             if (!cin_buf_inited) {
                 std::cout << "WARNING: cin not inited, using standard input" << std::endl;
@@ -969,6 +5387,8 @@ namespace libs {
             auto start = std::chrono::high_resolution_clock::now();
             (*func)(args...);
             auto end = std::chrono::high_resolution_clock::now();
+            std::cin.rdbuf(cin_backup);
+            in.set_mode(in_backup);
             std::cout << std::endl;
             int errors = 0;
             int tests = 0;
@@ -1561,4 +5981,23 @@ libs::c_dll_importer::import_function(const std::string& name) {
     if (func == 0) throw func_not_found_exception(name);
     return func;
 }
-#endif*/
\ No newline at end of file
+#endif*/
+
+#ifdef BIGINT_BENCHMARK
+// g++ -O2 -DBIGINT_BENCHMARK libs.cpp -o bigint_benchmark
+// ./bigint_benchmark [max limbs] prints the sweep for both limb kinds; ./bigint_benchmark tune > thresholds.h
+// measures the crossovers, and -DBIGINT_THRESHOLDS='"thresholds.h"' builds bigint against them
+int main(int argc, char **argv) {
+    if (argc > 1 && std::string(argv[1]) == "tune") {
+        std::cout << "// bigint thresholds measured by bigint_benchmark tune\n";
+        libs::bigint_benchmark().tune(std::cout);
+        libs::binary_bigint_benchmark().tune(std::cout);
+        return 0;
+    }
+    int max_limbs = argc > 1 ? std::atoi(argv[1]) : 8192;
+    libs::bigint_benchmark().run(std::cout, max_limbs);
+    std::cout << '\n';
+    libs::binary_bigint_benchmark().run(std::cout, max_limbs);
+    return 0;
+}
+#endif